@@ -15,6 +15,8 @@
  **/
 #include "decision/decision_engine.h"
 
+#include <algorithm>
+
 #include "decision/decision_attributes.h"
 #include "decision/justification_heuristic.h"
 #include "expr/node.h"
@@ -76,6 +78,24 @@ void DecisionEngine::clearStrategies(){
   d_needIteSkolemMap.clear();
 }
 
+void DecisionEngine::getSplitAtoms(unsigned k, std::vector<Node>& atoms)
+{
+  for (unsigned i = 0; i < d_enabledStrategies.size() && atoms.size() < k; ++i)
+  {
+    std::vector<Node> more;
+    d_enabledStrategies[i]->getSplitAtoms(k - atoms.size(), more);
+    for (const Node& atom : more)
+    {
+      if (std::find(atoms.begin(), atoms.end(), atom) == atoms.end())
+      {
+        atoms.push_back(atom);
+      }
+    }
+  }
+  Trace("decision") << "getSplitAtoms(" << k << ") returning " << atoms
+                    << std::endl;
+}
+
 bool DecisionEngine::isRelevant(SatVariable var)
 {
   Debug("decision") << "isRelevant(" << var <<")" << std::endl;
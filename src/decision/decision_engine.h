@@ -133,6 +133,12 @@ public:
     return ret;
   }
 
+  /**
+   * Get at most k unassigned atoms to split the search space on, as
+   * suggested by the enabled strategies, best first.
+   */
+  void getSplitAtoms(unsigned k, std::vector<Node>& atoms);
+
   /** Is a sat variable relevant */
   bool isRelevant(SatVariable var);
 
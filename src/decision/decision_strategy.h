@@ -19,6 +19,9 @@
 #ifndef CVC4__DECISION__DECISION_STRATEGY_H
 #define CVC4__DECISION__DECISION_STRATEGY_H
 
+#include <vector>
+
+#include "expr/node.h"
 #include "preprocessing/assertion_pipeline.h"
 #include "prop/sat_solver_types.h"
 #include "smt/term_formula_removal.h"
@@ -48,6 +51,12 @@ public:
   virtual bool needIteSkolemMap() { return false; }
 
   virtual void notifyAssertionsAvailable() { return; }
+
+  /**
+   * Suggest at most k unassigned atoms to split the search space on, best
+   * first. Strategies that know nothing about the input suggest nothing.
+   */
+  virtual void getSplitAtoms(unsigned k, std::vector<Node>& atoms) { return; }
 };/* class DecisionStrategy */
 
 class ITEDecisionStrategy : public DecisionStrategy {
@@ -18,6 +18,9 @@
  **/
 #include "justification_heuristic.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 #include "expr/kind.h"
 #include "expr/node_manager.h"
 #include "options/decision_options.h"
@@ -202,6 +205,152 @@ SatLiteral JustificationHeuristic::findSplitter(TNode node,
 }
 
 
+void JustificationHeuristic::getSplitAtoms(unsigned k,
+                                           std::vector<Node>& atoms)
+{
+  // Order the Boolean structure of the assertions so that every node comes
+  // after all of its parents, i.e. in reverse post-order
+  std::vector<TNode> roots;
+  for (unsigned i = 0; i < d_assertions.size(); ++i)
+  {
+    roots.push_back(d_assertions[i]);
+  }
+  for (SkolemMap::const_iterator i = d_iteAssertions.begin();
+       i != d_iteAssertions.end();
+       ++i)
+  {
+    roots.push_back((*i).second);
+  }
+  std::vector<TNode> order;
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<std::pair<TNode, bool> > stack;
+  for (TNode root : roots)
+  {
+    stack.push_back(std::make_pair(root, false));
+  }
+  while (!stack.empty())
+  {
+    TNode n = stack.back().first;
+    if (stack.back().second)
+    {
+      stack.pop_back();
+      order.push_back(n);
+      continue;
+    }
+    stack.back().second = true;
+    if (!visited.insert(n).second)
+    {
+      stack.pop_back();
+      continue;
+    }
+    if (!isAtom(n) && !checkJustified(n))
+    {
+      for (TNode child : n)
+      {
+        if (visited.find(child) == visited.end())
+        {
+          stack.push_back(std::make_pair(child, false));
+        }
+      }
+    }
+  }
+  std::reverse(order.begin(), order.end());
+
+  // The demand for the node to be true and for it to be false
+  typedef std::unordered_map<TNode, std::pair<double, double>, TNodeHashFunction>
+      DemandMap;
+  DemandMap demand;
+  for (TNode root : roots)
+  {
+    demand[root].first += 1;
+  }
+  std::vector<TNode> candidates;
+  for (TNode n : order)
+  {
+    const std::pair<double, double> d = demand[n];
+    if (checkJustified(n) || (d.first == 0 && d.second == 0))
+    {
+      continue;
+    }
+    if (isAtom(n))
+    {
+      if (tryGetSatValue(n) == SAT_VALUE_UNKNOWN
+          && d_decisionEngine->hasSatLiteral(n))
+      {
+        candidates.push_back(n);
+      }
+      continue;
+    }
+    unsigned numChildren = n.getNumChildren();
+    switch (n.getKind())
+    {
+      case kind::NOT:
+        demand[n[0]].first += d.second;
+        demand[n[0]].second += d.first;
+        break;
+      case kind::AND:
+        for (TNode child : n)
+        {
+          demand[child].first += d.first;
+          demand[child].second += d.second / numChildren;
+        }
+        break;
+      case kind::OR:
+        for (TNode child : n)
+        {
+          demand[child].first += d.first / numChildren;
+          demand[child].second += d.second;
+        }
+        break;
+      case kind::IMPLIES:
+        demand[n[0]].first += d.second;
+        demand[n[0]].second += d.first / 2;
+        demand[n[1]].first += d.first / 2;
+        demand[n[1]].second += d.second;
+        break;
+      case kind::XOR:
+      case kind::EQUAL:
+        // Both children need a value, whichever it is
+        for (TNode child : n)
+        {
+          demand[child].first += (d.first + d.second) / 2;
+          demand[child].second += (d.first + d.second) / 2;
+        }
+        break;
+      case kind::ITE:
+        demand[n[0]].first += (d.first + d.second) / 2;
+        demand[n[0]].second += (d.first + d.second) / 2;
+        for (unsigned i = 1; i < 3; ++i)
+        {
+          demand[n[i]].first += d.first / 2;
+          demand[n[i]].second += d.second / 2;
+        }
+        break;
+      default: break;
+    }
+  }
+
+  // Best first, ties broken by the order of the assertions
+  std::stable_sort(candidates.begin(),
+                   candidates.end(),
+                   [&demand](TNode a, TNode b) {
+                     return demand[a].first + demand[a].second
+                            > demand[b].first + demand[b].second;
+                   });
+  for (unsigned i = 0; i < candidates.size() && atoms.size() < k; ++i)
+  {
+    atoms.push_back(candidates[i]);
+  }
+}
+
+bool JustificationHeuristic::isAtom(TNode n)
+{
+  Kind k = n.getKind();
+  return k == kind::BOOLEAN_TERM_VARIABLE
+         || (theory::kindToTheoryId(k) != theory::THEORY_BOOL
+             && (k != kind::EQUAL || !n[0].getType().isBoolean()));
+}
+
 void JustificationHeuristic::setJustified(TNode n)
 {
   d_justified.insert(n);
@@ -450,22 +599,18 @@ JustificationHeuristic::findSplitterRec(TNode node, SatValue desiredVal)
 
   /* What type of node is this */
   Kind k = node.getKind();
-  theory::TheoryId tId = theory::kindToTheoryId(k);
-  bool isAtom =
-     (k == kind::BOOLEAN_TERM_VARIABLE ) ||
-     ( (tId != theory::THEORY_BOOL) &&
-       (k != kind::EQUAL || (!node[0].getType().isBoolean())) );
 
   /* Some debugging stuff */
   Debug("decision::jh") << "kind = " << k << std::endl
-                        << "theoryId = " << tId << std::endl
+                        << "theoryId = " << theory::kindToTheoryId(k)
+                        << std::endl
                         << "node = " << node << std::endl
                         << "litVal = " << litVal << std::endl;
 
   /**
    * If not in theory of booleans, check if this is something to split-on.
    */
-  if(isAtom) {
+  if(isAtom(node)) {
     // if node has embedded ites, resolve that first
     if(handleEmbeddedITEs(node) == FOUND_SPLITTER)
       return FOUND_SPLITTER;
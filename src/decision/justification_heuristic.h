@@ -123,6 +123,14 @@ public:
   void addAssertions(
       const preprocessing::AssertionPipeline &assertions) override;
 
+  /**
+   * Suggest the unassigned atoms the justification of the assertions depends
+   * on most. Every assertion has a demand of 1, which flows down its Boolean
+   * structure: a child that must have a value gets the whole demand of its
+   * parent, one of n children that may justify the parent gets 1/n of it.
+   */
+  void getSplitAtoms(unsigned k, std::vector<Node>& atoms) override;
+
  private:
   /* getNext with an option to specify threshold */
   prop::SatLiteral getNextThresh(bool &stopSearch, DecisionWeight threshold);
@@ -135,6 +143,7 @@ public:
   SearchResult findSplitterRec(TNode node, SatValue value);
 
   /* Helper functions */
+  static bool isAtom(TNode);
   void setJustified(TNode);
   bool checkJustified(TNode);
   DecisionWeight getExploredThreshold(TNode);
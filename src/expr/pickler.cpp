@@ -469,6 +469,10 @@ Pickle::~Pickle() {
   delete d_data;
 }
 
+std::string Pickle::toString() const {
+  return d_data->toString();
+}
+
 uint64_t MapPickler::variableFromMap(uint64_t x) const 
 {
   VarMap::const_iterator i = d_fromMap.find(x);
@@ -49,6 +49,12 @@ public:
   Pickle(const Pickle& p);
   ~Pickle();
   Pickle& operator=(const Pickle& other);
+
+  /**
+   * A string representation of the contents. Two pickles of the same
+   * expression (with the same variable map) have the same representation.
+   */
+  std::string toString() const;
 };/* class Pickle */
 
 class CVC4_PUBLIC PicklingException : public Exception {
@@ -21,6 +21,7 @@
 #  include <unistd.h>
 #endif /* HAVE_UNISTD_H */
 
+#include <algorithm>
 #include <boost/exception_ptr.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/thread.hpp>
@@ -41,6 +42,8 @@ using namespace std;
 namespace CVC4 {
 namespace main {
 
+const unsigned CommandExecutorPortfolio::s_maxCubeDepth;
+
 CommandExecutorPortfolio::CommandExecutorPortfolio(api::Solver* solver,
                                                    Options& options,
                                                    OptionsList& tOpts)
@@ -51,8 +54,12 @@ CommandExecutorPortfolio::CommandExecutorPortfolio(api::Solver* solver,
       d_threadOptions(tOpts),
       d_vmaps(),
       d_lastWinner(0),
-      d_channelsOut(),
-      d_channelsIn(),
+      d_inSync(d_numThreads, true),
+      d_cubeAndConquer(options.getCubeDepth() > 0 && d_numThreads > 1
+                       && (options.getIncrementalSolving()
+                           || !options.wasSetByUserIncrementalSolving())),
+      d_sharedClauses(NULL),
+      d_sharedAtoms(NULL),
       d_ostringstreams(),
       d_statLastWinner("portfolio::lastWinner"),
       d_statWaitTime("portfolio::waitTime")
@@ -78,6 +85,13 @@ CommandExecutorPortfolio::CommandExecutorPortfolio(api::Solver* solver,
     d_smts.push_back(solver->getSmtEngine());
     d_vmaps.push_back(new ExprManagerMapCollection());
   }
+
+  if(d_cubeAndConquer) {
+    // Each thread solves many cubes of the same check-sat
+    for(unsigned i = 0; i < d_numThreads; ++i) {
+      d_smts[i]->setOption("incremental", SExpr(true));
+    }
+  }
 }
 
 CommandExecutorPortfolio::~CommandExecutorPortfolio()
@@ -101,36 +115,23 @@ CommandExecutorPortfolio::~CommandExecutorPortfolio()
 
 void CommandExecutorPortfolio::lemmaSharingInit()
 {
-  /* Sharing channels */
-  assert(d_channelsIn.size() == 0);
-  assert(d_channelsOut.size() == 0);
-
   if(d_numThreads == 1) {
     // Disable sharing
     d_threadOptions[0].setSharingFilterByLength(0);
   } else {
-    // Setup sharing channels
-    const unsigned int sharingChannelSize = 1000000;
-
-    for(unsigned i = 0; i < d_numThreads; ++i){
-      d_channelsOut.push_back(
-          new SynchronizedSharedChannel<ChannelFormat>(sharingChannelSize));
-      d_channelsIn.push_back(
-          new SynchronizedSharedChannel<ChannelFormat>(sharingChannelSize));
-    }
-
-    /* Lemma I/O channels */
+    /* Learned clauses are shared by the SAT solvers directly */
+    const size_t sharedClauseBufferSize = 1 << 14;
+    d_sharedClauses = new SharedClauseBuffer(sharedClauseBufferSize);
+    d_sharedAtoms = new SharedAtomTable();
     for(unsigned i = 0; i < d_numThreads; ++i) {
       int thread_id = d_threadOptions[i].getThreadId();
       string tag = "thread #" + boost::lexical_cast<string>(thread_id);
-      LemmaOutputChannel* outputChannel =
-          new PortfolioLemmaOutputChannel(tag, d_channelsOut[i], d_exprMgrs[i],
-                                          d_vmaps[i]->d_from, d_vmaps[i]->d_to);
-      LemmaInputChannel* inputChannel =
-          new PortfolioLemmaInputChannel(tag, d_channelsIn[i], d_exprMgrs[i],
-                                         d_vmaps[i]->d_from, d_vmaps[i]->d_to);
-      d_smts[i]->channels()->setLemmaInputChannel(inputChannel);
-      d_smts[i]->channels()->setLemmaOutputChannel(outputChannel);
+      ClauseSharingChannel* clauseChannel =
+          new PortfolioClauseSharingChannel(tag, i, d_sharedClauses,
+                                            d_sharedAtoms, d_exprMgrs[i],
+                                            d_vmaps[i]->d_from,
+                                            d_vmaps[i]->d_to);
+      d_smts[i]->channels()->setClauseSharingChannel(clauseChannel);
     }
 
     /* Output to string stream  */
@@ -154,18 +155,14 @@ void CommandExecutorPortfolio::lemmaSharingCleanup()
     return;
 
   // Channel cleanup
-  assert(d_channelsIn.size() == d_numThreads);
-  assert(d_channelsOut.size() == d_numThreads);
   for(unsigned i = 0; i < d_numThreads; ++i) {
-    delete d_channelsIn[i];
-    delete d_channelsOut[i];
-    delete d_smts[i]->channels()->getLemmaInputChannel();
-    d_smts[i]->channels()->setLemmaInputChannel(NULL);
-    delete d_smts[i]->channels()->getLemmaOutputChannel();
-    d_smts[i]->channels()->setLemmaOutputChannel(NULL);
+    delete d_smts[i]->channels()->getClauseSharingChannel();
+    d_smts[i]->channels()->setClauseSharingChannel(NULL);
   }
-  d_channelsIn.clear();
-  d_channelsOut.clear();
+  delete d_sharedClauses;
+  d_sharedClauses = NULL;
+  delete d_sharedAtoms;
+  d_sharedAtoms = NULL;
 
   // sstreams cleanup (if used)
   if(d_ostringstreams.size() != 0) {
@@ -180,6 +177,160 @@ void CommandExecutorPortfolio::lemmaSharingCleanup()
 }/* CommandExecutorPortfolio::lemmaSharingCleanup() */
 
 
+void CommandExecutorPortfolio::mapFirstThreadVariables()
+{
+  /**
+   * Create identity variable map for the first thread, with only
+   * those variables which have a corresponding variable in
+   * another thread. (TODO: Also assert, all threads have the same
+   * set of variables mapped.)
+   */
+  if(d_numThreads >= 2) {
+    VarMap& thread_0_from = d_vmaps[0]->d_from;
+    VarMap& thread_1_to = d_vmaps[1]->d_to;
+    for(VarMap::iterator i=thread_1_to.begin();
+        i != thread_1_to.end(); ++i) {
+      thread_0_from[i->first] = i->first;
+    }
+    d_vmaps[0]->d_to = thread_0_from;
+  }
+}/* CommandExecutorPortfolio::mapFirstThreadVariables() */
+
+bool CommandExecutorPortfolio::doCubeAndConquer(bool& status)
+{
+  /* Bring the other threads up to date */
+  std::vector<Command*> seqs(d_numThreads, NULL);
+  for(unsigned i = 0; i < d_numThreads; ++i) {
+    if(int(i) == d_lastWinner || !d_inSync[i]) {
+      continue;
+    }
+    try {
+      seqs[i] = i == 0 ? d_seq->clone()
+                       : d_seq->exportTo(d_exprMgrs[i], *(d_vmaps[i]));
+    } catch(ExportUnsupportedException& e) {
+      for(unsigned j = 0; j < i; ++j) {
+        delete seqs[j];
+      }
+      // Let the race deal with it
+      return false;
+    }
+  }
+  mapFirstThreadVariables();
+  // A thread that failed to replay the commands would miss some of the
+  // assertions, so it takes no part in solving this or any later query
+  std::vector<unsigned> workers;
+  for(unsigned i = 0; i < d_numThreads; ++i) {
+    if(seqs[i] != NULL) {
+      bool caughtUp = smtEngineInvoke(d_smts[i], seqs[i], NULL);
+      delete seqs[i];
+      if(!caughtUp) {
+        Notice() << "thread #" << i << " could not catch up for cube-and-conquer"
+                 << std::endl;
+        d_inSync[i] = false;
+      }
+    }
+    if(d_inSync[i]) {
+      workers.push_back(i);
+    }
+  }
+  delete d_seq;
+  d_seq = new CommandSequence();
+
+  // The split atoms come from the first thread. Otherwise all the threads
+  // left in sync are up to date, and race with an empty d_seq.
+  if(workers.empty() || workers[0] != 0) {
+    return false;
+  }
+
+  /* Lookahead */
+  unsigned depth = std::min(d_options.getCubeDepth(), s_maxCubeDepth);
+  std::vector<Expr> atoms;
+  try {
+    atoms = d_smts[0]->getSplitAtoms(depth);
+  } catch(Exception& e) {
+    Notice() << "no atoms for cube-and-conquer: " << e.getMessage()
+             << std::endl;
+  }
+  if(atoms.empty()) {
+    return false;
+  }
+  Trace("cubes") << "splitting on " << atoms << std::endl;
+
+  std::vector< std::vector<Expr> > threadAtoms(d_numThreads);
+  for(unsigned i : workers) {
+    for(const Expr& atom : atoms) {
+      threadAtoms[i].push_back(
+          i == 0 ? atom : atom.exportTo(d_exprMgrs[i], *(d_vmaps[i])));
+    }
+  }
+
+  /* Conquer */
+  lemmaSharingInit();
+
+  CubeQueue queue(d_smts, atoms.size());
+  boost::function<bool()>* fns = new boost::function<bool()>[workers.size()];
+  for(unsigned k = 0; k < workers.size(); ++k) {
+    unsigned i = workers[k];
+    fns[k] = boost::bind(solveCubes, i, d_smts[i], &threadAtoms[i], &queue);
+  }
+  size_t threadStackSize = d_options.getThreadStackSize();
+  threadStackSize *= 1024 * 1024;
+  runAll(workers.size(), fns, threadStackSize);
+  delete[] fns;
+
+  d_result = queue.getResult();
+  if(queue.getWinner() >= 0) {
+    d_lastWinner = queue.getWinner();
+  }
+  if(d_options.getVerbosity() >= -1) {
+    *d_options.getOut() << d_result << std::endl;
+  }
+
+  lemmaSharingCleanup();
+
+  status = true;
+  return true;
+}/* CommandExecutorPortfolio::doCubeAndConquer() */
+
+bool CommandExecutorPortfolio::dumpQueryResult(bool status)
+{
+  // dump the model/proof/unsat core if option is set
+  if(status) {
+    if( d_options.getProduceModels() &&
+        d_options.getDumpModels() &&
+        ( d_result.asSatisfiabilityResult() == Result::SAT ||
+          (d_result.isUnknown() &&
+           d_result.whyUnknown() == Result::INCOMPLETE) ) )
+    {
+      Command* gm = new GetModelCommand();
+      status = doCommandSingleton(gm);
+    } else if( d_options.getProof() &&
+               d_options.getDumpProofs() &&
+               d_result.asSatisfiabilityResult() == Result::UNSAT ) {
+      Command* gp = new GetProofCommand();
+      status = doCommandSingleton(gp);
+    } else if( d_options.getDumpInstantiations() &&
+               ( ( d_options.getInstFormatMode() != INST_FORMAT_MODE_SZS &&
+                 ( d_result.asSatisfiabilityResult() == Result::SAT ||
+                   (d_result.isUnknown() &&
+                    d_result.whyUnknown() == Result::INCOMPLETE) ) ) ||
+                 d_result.asSatisfiabilityResult() == Result::UNSAT ) ) {
+      Command* gi = new GetInstantiationsCommand();
+      status = doCommandSingleton(gi);
+    } else if( d_options.getDumpSynth() &&
+               d_result.asSatisfiabilityResult() == Result::UNSAT ){
+      Command* gi = new GetSynthSolutionCommand();
+      status = doCommandSingleton(gi);
+    } else if( d_options.getDumpUnsatCores() &&
+               d_result.asSatisfiabilityResult() == Result::UNSAT ) {
+      Command* guc = new GetUnsatCoreCommand();
+      status = doCommandSingleton(guc);
+    }
+  }
+
+  return status;
+}/* CommandExecutorPortfolio::dumpQueryResult() */
+
 bool CommandExecutorPortfolio::doCommandSingleton(Command* cmd)
 {
   /**
@@ -232,6 +383,14 @@ bool CommandExecutorPortfolio::doCommandSingleton(Command* cmd)
     if(d_lastWinner != 0) delete cmdExported;
     return ret;
   } else if(mode == 1) {               // portfolio
+    CheckSatCommand* checkSat = dynamic_cast<CheckSatCommand*>(cmd);
+    if(d_cubeAndConquer && checkSat != NULL && checkSat->getExpr().isNull()) {
+      bool status;
+      if(doCubeAndConquer(status)) {
+        return dumpQueryResult(status);
+      }
+    }
+
     d_seq->addCommand(cmd->clone());
 
     // We currently don't support changing number of threads for each
@@ -239,6 +398,17 @@ bool CommandExecutorPortfolio::doCommandSingleton(Command* cmd)
     // can be achieved without a lot of work.
     Command *seqs[d_numThreads];
 
+    // Only the threads that are in sync take part
+    std::vector<unsigned> threads;
+    std::vector<SmtEngine*> threadSmts;
+    for(unsigned i = 0; i < d_numThreads; ++i) {
+      if(d_inSync[i]) {
+        threads.push_back(i);
+        threadSmts.push_back(d_smts[i]);
+      }
+    }
+    assert(d_inSync[d_lastWinner]);
+
     if(d_lastWinner == 0)
       seqs[0] = cmd;
     else
@@ -246,6 +416,10 @@ bool CommandExecutorPortfolio::doCommandSingleton(Command* cmd)
 
     /* variable maps and exporting */
     for(unsigned i = 1; i < d_numThreads; ++i) {
+      if(!d_inSync[i]) {
+        seqs[i] = NULL;
+        continue;
+      }
       /**
        * vmaps[i].d_from [x] = y means
        *    that in thread #0's expr manager id is y
@@ -273,54 +447,33 @@ bool CommandExecutorPortfolio::doCommandSingleton(Command* cmd)
       }
     }
 
-    /**
-     * Create identity variable map for the first thread, with only
-     * those variables which have a corresponding variable in
-     * another thread. (TODO: Also assert, all threads have the same
-     * set of variables mapped.)
-     */
-    if(d_numThreads >= 2) {
-      VarMap& thread_0_from = d_vmaps[0]->d_from;
-      VarMap& thread_1_to = d_vmaps[1]->d_to;
-      for(VarMap::iterator i=thread_1_to.begin();
-          i != thread_1_to.end(); ++i) {
-        thread_0_from[i->first] = i->first;
-      }
-      d_vmaps[0]->d_to = thread_0_from;
-    }
+    mapFirstThreadVariables();
 
     lemmaSharingInit();
 
     /* Portfolio */
-    boost::function<bool()>* fns = new boost::function<bool()>[d_numThreads];
-    for(unsigned i = 0; i < d_numThreads; ++i) {
+    boost::function<bool()>* fns = new boost::function<bool()>[threads.size()];
+    for(unsigned k = 0; k < threads.size(); ++k) {
+      unsigned i = threads[k];
       std::ostream* current_out_or_null = d_options.getVerbosity() >= -1 ?
           d_threadOptions[i].getOut() : NULL;
 
-      fns[i] = boost::bind(smtEngineInvoke, d_smts[i], seqs[i],
+      fns[k] = boost::bind(smtEngineInvoke, d_smts[i], seqs[i],
                            current_out_or_null);
     }
 
-    assert(d_channelsIn.size() == d_numThreads
-           || d_numThreads == 1);
-    assert(d_channelsOut.size() == d_numThreads
-           || d_numThreads == 1);
     assert(d_smts.size() == d_numThreads);
     assert( !d_statWaitTime.running() );
 
     boost::function<void()>
-      smFn = d_numThreads <= 1 ? boost::function<void()>() :
-             boost::bind(sharingManager<ChannelFormat>,
-                         d_numThreads,
-                         &d_channelsOut[0],
-                         &d_channelsIn[0],
-                         &d_smts[0]);
+      smFn = threads.size() <= 1 ? boost::function<void()>() :
+             boost::bind(sharingManager, threads.size(), &threadSmts[0]);
 
     size_t threadStackSize = d_options.getThreadStackSize();
     threadStackSize *= 1024 * 1024;
 
     pair<int, bool> portfolioReturn =
-        runPortfolio(d_numThreads, smFn, fns, threadStackSize,
+        runPortfolio(threads.size(), smFn, fns, threadStackSize,
                      d_options.getWaitToJoin(), d_statWaitTime);
 
 #ifdef CVC4_STATISTICS_ON
@@ -328,6 +481,9 @@ bool CommandExecutorPortfolio::doCommandSingleton(Command* cmd)
     d_statWaitTime.stop();
 #endif /* CVC4_STATISTICS_ON */
 
+    assert(portfolioReturn.first >= 0);
+    assert(unsigned(portfolioReturn.first) < threads.size());
+    portfolioReturn.first = threads[portfolioReturn.first];
     d_lastWinner = portfolioReturn.first;
     d_result = d_smts[d_lastWinner]->getStatusOfLastCommand();
 
@@ -366,43 +522,7 @@ bool CommandExecutorPortfolio::doCommandSingleton(Command* cmd)
 
     delete[] fns;
 
-    bool status = portfolioReturn.second;
-
-    // dump the model/proof/unsat core if option is set
-    if(status) {
-      if( d_options.getProduceModels() &&
-          d_options.getDumpModels() &&
-          ( d_result.asSatisfiabilityResult() == Result::SAT ||
-            (d_result.isUnknown() &&
-             d_result.whyUnknown() == Result::INCOMPLETE) ) )
-      {
-        Command* gm = new GetModelCommand();
-        status = doCommandSingleton(gm);
-      } else if( d_options.getProof() &&
-                 d_options.getDumpProofs() &&
-                 d_result.asSatisfiabilityResult() == Result::UNSAT ) {
-        Command* gp = new GetProofCommand();
-        status = doCommandSingleton(gp);
-      } else if( d_options.getDumpInstantiations() &&
-                 ( ( d_options.getInstFormatMode() != INST_FORMAT_MODE_SZS &&
-                   ( d_result.asSatisfiabilityResult() == Result::SAT ||
-                     (d_result.isUnknown() &&
-                      d_result.whyUnknown() == Result::INCOMPLETE) ) ) ||
-                   d_result.asSatisfiabilityResult() == Result::UNSAT ) ) {
-        Command* gi = new GetInstantiationsCommand();
-        status = doCommandSingleton(gi);
-      } else if( d_options.getDumpSynth() &&
-                 d_result.asSatisfiabilityResult() == Result::UNSAT ){
-        Command* gi = new GetSynthSolutionCommand();
-        status = doCommandSingleton(gi);
-      } else if( d_options.getDumpUnsatCores() &&
-                 d_result.asSatisfiabilityResult() == Result::UNSAT ) {
-        Command* guc = new GetUnsatCoreCommand();
-        status = doCommandSingleton(guc);
-      }
-    }
-
-    return status;
+    return dumpQueryResult(portfolioReturn.second);
   } else if(mode == 2) {
     Command* cmdExported = d_lastWinner == 0 ?
         cmd : cmd->exportTo(d_exprMgrs[d_lastWinner], *(d_vmaps[d_lastWinner]));
@@ -50,9 +50,22 @@ class CommandExecutorPortfolio : public CommandExecutor {
 
   int d_lastWinner;
 
+  /**
+   * Whether each thread has seen all the commands before d_seq. A thread that
+   * failed to replay them stays behind, and takes no part in later races and
+   * cube-and-conquer.
+   */
+  std::vector<bool> d_inSync;
+
+  /**
+   * Whether check-sats are solved by cube-and-conquer, which needs several
+   * threads, all of them in incremental mode.
+   */
+  const bool d_cubeAndConquer;
+
   // These shall be reset for each check-sat
-  std::vector< SharedChannel<ChannelFormat>* > d_channelsOut;
-  std::vector< SharedChannel<ChannelFormat>* > d_channelsIn;
+  SharedClauseBuffer* d_sharedClauses;
+  SharedAtomTable* d_sharedAtoms;
   std::vector<std::ostringstream*> d_ostringstreams;
 
   // Stats
@@ -77,6 +90,22 @@ private:
   CommandExecutorPortfolio();
   void lemmaSharingInit();
   void lemmaSharingCleanup();
+  void mapFirstThreadVariables();
+
+  /**
+   * Solve a check-sat by cube-and-conquer: all the threads are brought up to
+   * date, the first one suggests the atoms to split on, and the threads that
+   * caught up solve the cubes over these atoms. Returns false if no atoms
+   * were found or the first thread could not catch up; the caller then races
+   * the threads that are still in sync instead.
+   */
+  bool doCubeAndConquer(bool& status);
+
+  /** Dump the model, proof, etc. of the last query, as requested. */
+  bool dumpQueryResult(bool status);
+
+  /** Cube-and-conquer splits on at most this many atoms */
+  static const unsigned s_maxCubeDepth = 16;
 };/* class CommandExecutorPortfolio */
 
 }/* CVC4::main namespace */
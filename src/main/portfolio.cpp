@@ -58,6 +58,26 @@ void runThread(int thread_id, boost::function<S()> threadFn, S& returnValue)
   }
 }
 
+/** Start a worker thread with the given stack size (0 for the default) */
+boost::thread startThread(boost::function<void()> fn, size_t stackSize)
+{
+#if BOOST_HAS_THREAD_ATTR
+  boost::thread::attributes attrs;
+
+  if(stackSize > 0) {
+    attrs.set_stack_size(stackSize);
+  }
+
+  return boost::thread(attrs, fn);
+#else /* BOOST_HAS_THREAD_ATTR */
+  if(stackSize > 0) {
+    throw OptionException("cannot specify a stack size for worker threads; requires CVC4 to be built with Boost thread library >= 1.50.0");
+  }
+
+  return boost::thread(fn);
+#endif /* BOOST_HAS_THREAD_ATTR */
+}
+
 template<typename T, typename S>
 std::pair<int, S> runPortfolio(int numThreads,
                                boost::function<T()> driverFn,
@@ -74,26 +94,10 @@ std::pair<int, S> runPortfolio(int numThreads,
 
   for(int t = 0; t < numThreads; ++t) {
 
-#if BOOST_HAS_THREAD_ATTR
-    boost::thread::attributes attrs;
-
-    if(stackSize > 0) {
-      attrs.set_stack_size(stackSize);
-    }
-
-    threads[t] =
-      boost::thread(attrs, boost::bind(runThread<S>, t, threadFns[t],
-                                       boost::ref(threads_returnValue[t]) ) );
-#else /* BOOST_HAS_THREAD_ATTR */
-    if(stackSize > 0) {
-      throw OptionException("cannot specify a stack size for worker threads; requires CVC4 to be built with Boost thread library >= 1.50.0");
-    }
-
     threads[t] =
-      boost::thread(boost::bind(runThread<S>, t, threadFns[t],
-                                boost::ref(threads_returnValue[t]) ) );
-
-#endif /* BOOST_HAS_THREAD_ATTR */
+      startThread(boost::bind(runThread<S>, t, threadFns[t],
+                              boost::ref(threads_returnValue[t]) ),
+                  stackSize);
 
 #if defined(BOOST_THREAD_PLATFORM_PTHREAD)
     if(Chat.isOn()) {
@@ -136,6 +140,22 @@ std::pair<int, S> runPortfolio(int numThreads,
   return retval;
 }
 
+void runAll(int numThreads,
+            boost::function<bool()> threadFns[],
+            size_t stackSize) {
+  boost::thread* threads = new boost::thread[numThreads];
+
+  for(int t = 0; t < numThreads; ++t) {
+    threads[t] = startThread(threadFns[t], stackSize);
+  }
+
+  for(int t = 0; t < numThreads; ++t) {
+    threads[t].join();
+  }
+
+  delete[] threads;
+}
+
 // instantiation
 template
 std::pair<int, bool>
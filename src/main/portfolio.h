@@ -36,6 +36,11 @@ std::pair<int, S> runPortfolio(int numThreads,
 // as we have defined things, S=void would give compile errors
 // do we want to fix this? yes, no, maybe?
 
+/** Run all the functions in their own threads, and wait for all of them. */
+void runAll(int numThreads,
+            boost::function<bool()> threadFns[],
+            size_t stackSize);
+
 }/* CVC4 namespace */
 
 #endif /* CVC4__PORTFOLIO_H */
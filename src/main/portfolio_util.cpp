@@ -16,9 +16,12 @@
 
 #include <unistd.h>
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 
+#include <boost/thread.hpp>
+
 #include "options/options.h"
 
 using namespace std;
@@ -114,48 +117,272 @@ void parseThreadSpecificOptions(OptionsList& threadOptions, const Options& opts)
   assert(numThreads >= 1);      //do we need this?
 }
 
-void PortfolioLemmaOutputChannel::notifyNewLemma(Expr lemma) {
-  if(int(lemma.getNumChildren()) > Options::currentGetSharingFilterByLength()) {
-    return;
+const unsigned SharedClauseBuffer::s_maxClauseSize;
+
+SharedClauseBuffer::SharedClauseBuffer(size_t capacity)
+    : d_slots(capacity), d_head(0)
+{
+  for(Slot& slot : d_slots) {
+    slot.d_seq.store(0, std::memory_order_relaxed);
+    slot.d_producer.store(0, std::memory_order_relaxed);
+    slot.d_size.store(0, std::memory_order_relaxed);
   }
-  ++cnt;
-  Trace("sharing") << d_tag << ": " << lemma << std::endl;
-  expr::pickle::Pickle pkl;
-  try {
-    d_pickler.toPickle(lemma, pkl);
-    d_sharedChannel->push(pkl);
-    if(Trace.isOn("showSharing") && Options::currentGetThreadId() == 0) {
-      (*(Options::currentGetOut()))
-          << "thread #0: notifyNewLemma: " << lemma << std::endl;
+}
+
+bool SharedClauseBuffer::push(unsigned producer,
+                              const std::vector<uint32_t>& lits) {
+  if(lits.size() > s_maxClauseSize) {
+    return false;
+  }
+  uint64_t ticket = d_head.fetch_add(1, std::memory_order_relaxed);
+  Slot& slot = d_slots[ticket % d_slots.size()];
+
+  // Take the slot unless somebody is writing it, or a later ticket already
+  // took it over
+  uint64_t seq = slot.d_seq.load(std::memory_order_relaxed);
+  if((seq & 1) != 0 || seq > 2 * ticket ||
+     !slot.d_seq.compare_exchange_strong(seq, 2 * ticket + 1,
+                                         std::memory_order_relaxed)) {
+    return false;
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.d_producer.store(producer, std::memory_order_relaxed);
+  slot.d_size.store(lits.size(), std::memory_order_relaxed);
+  for(unsigned i = 0; i < lits.size(); ++i) {
+    slot.d_lits[i].store(lits[i], std::memory_order_relaxed);
+  }
+  slot.d_seq.store(2 * ticket + 2, std::memory_order_release);
+  return true;
+}
+
+bool SharedClauseBuffer::pop(unsigned consumer, uint64_t& pos,
+                             std::vector<uint32_t>& lits) {
+  uint64_t head = d_head.load(std::memory_order_acquire);
+  if(head > pos + d_slots.size()) {
+    // Fell behind, the oldest clauses are lost
+    pos = head - d_slots.size();
+  }
+  while(pos < head) {
+    uint64_t ticket = pos;
+    Slot& slot = d_slots[ticket % d_slots.size()];
+    uint64_t seq = slot.d_seq.load(std::memory_order_acquire);
+    if(seq == 2 * ticket + 1) {
+      // Still being written, come back later
+      return false;
+    }
+    ++pos;
+    if(seq != 2 * ticket + 2) {
+      // Dropped by its producer, or already overwritten
+      continue;
+    }
+
+    unsigned producer = slot.d_producer.load(std::memory_order_relaxed);
+    unsigned size = slot.d_size.load(std::memory_order_relaxed);
+    lits.resize(std::min(size, s_maxClauseSize));
+    for(unsigned i = 0; i < lits.size(); ++i) {
+      lits[i] = slot.d_lits[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(slot.d_seq.load(std::memory_order_relaxed) != seq) {
+      // Overwritten while we were reading
+      continue;
+    }
+    if(producer != consumer) {
+      return true;
     }
-  } catch(expr::pickle::PicklingException& p){
-    Trace("sharing::blocked") << lemma << std::endl;
   }
+  return false;
 }
 
+uint32_t SharedAtomTable::getId(const expr::pickle::Pickle& atom) {
+  std::string key = atom.toString();
+  boost::mutex::scoped_lock lock(d_mutex);
+  std::unordered_map<std::string, uint32_t>::const_iterator it =
+      d_ids.find(key);
+  if(it != d_ids.end()) {
+    return it->second;
+  }
+  uint32_t id = d_atoms.size();
+  d_ids[key] = id;
+  d_atoms.push_back(atom);
+  return id;
+}
 
-PortfolioLemmaInputChannel::PortfolioLemmaInputChannel(std::string tag,
-    SharedChannel<ChannelFormat>* c,
+expr::pickle::Pickle SharedAtomTable::getAtom(uint32_t id) {
+  boost::mutex::scoped_lock lock(d_mutex);
+  assert(id < d_atoms.size());
+  return d_atoms[id];
+}
+
+PortfolioClauseSharingChannel::PortfolioClauseSharingChannel(
+    std::string tag,
+    unsigned threadId,
+    SharedClauseBuffer* buffer,
+    SharedAtomTable* atoms,
     ExprManager* em,
     VarMap& to,
     VarMap& from)
-    : d_tag(tag), d_sharedChannel(c), d_pickler(em, to, from)
+    : d_tag(tag),
+      d_threadId(threadId),
+      d_buffer(buffer),
+      d_atoms(atoms),
+      d_pickler(em, to, from),
+      d_readPos(0)
 {}
 
-bool PortfolioLemmaInputChannel::hasNewLemma(){
-  Debug("lemmaInputChannel") << d_tag << ": " << "hasNewLemma" << std::endl;
-  return !d_sharedChannel->empty();
+bool PortfolioClauseSharingChannel::getAtomId(Expr atom, uint32_t& id) {
+  expr::pickle::Pickle pkl;
+  try {
+    d_pickler.toPickle(atom, pkl);
+  } catch(expr::pickle::PicklingException& p) {
+    Trace("sharing::blocked") << d_tag << ": " << atom << std::endl;
+    return false;
+  }
+  id = d_atoms->getId(pkl);
+  Trace("sharing") << d_tag << ": atom " << id << " is " << atom << std::endl;
+  return true;
+}
+
+Expr PortfolioClauseSharingChannel::getAtom(uint32_t id) {
+  expr::pickle::Pickle pkl = d_atoms->getAtom(id);
+  return d_pickler.fromPickle(pkl);
+}
+
+void PortfolioClauseSharingChannel::exportClause(
+    const std::vector<uint32_t>& lits) {
+  if(!d_buffer->push(d_threadId, lits)) {
+    Trace("sharing::blocked") << d_tag << ": dropped clause" << std::endl;
+  }
+}
+
+bool PortfolioClauseSharingChannel::importClause(std::vector<uint32_t>& lits) {
+  return d_buffer->pop(d_threadId, d_readPos, lits);
 }
 
-Expr PortfolioLemmaInputChannel::getNewLemma() {
-  Debug("lemmaInputChannel") << d_tag << ": " << "getNewLemma" << std::endl;
-  expr::pickle::Pickle pkl = d_sharedChannel->pop();
+CubeQueue::CubeQueue(const std::vector<SmtEngine*>& smts, unsigned numAtoms)
+    : d_smts(smts),
+      d_numCubes(1u << numAtoms),
+      d_nextCube(0),
+      d_numUnsat(0),
+      d_winner(-1),
+      d_unknown()
+{
+}
+
+bool CubeQueue::next(unsigned& cube) {
+  boost::lock_guard<boost::mutex> lock(d_mutex);
+  if(d_winner >= 0 || d_nextCube == d_numCubes) {
+    return false;
+  }
+  cube = d_nextCube++;
+  return true;
+}
+
+void CubeQueue::report(unsigned thread, unsigned cube, const Result& result) {
+  boost::lock_guard<boost::mutex> lock(d_mutex);
+  Trace("cubes") << "thread #" << thread << ": cube " << cube << " is "
+                 << result << std::endl;
+  if(d_winner >= 0) {
+    // Somebody else was faster, this result is probably an interrupt
+    return;
+  }
+  switch(result.asSatisfiabilityResult().isSat()) {
+  case Result::UNSAT:
+    ++d_numUnsat;
+    break;
+  case Result::SAT:
+    d_winner = thread;
+    for(unsigned t = 0; t < d_smts.size(); ++t) {
+      if(t != thread) {
+        try {
+          d_smts[t]->interrupt();
+        } catch(ModalException& e) {
+          Trace("interrupt") << "Could not interrupt thread #" << t
+                             << std::endl;
+        }
+      }
+    }
+    break;
+  default:
+    if(d_unknown.isNull()) {
+      d_unknown = result;
+    }
+    break;
+  }
+}
 
-  Expr e = d_pickler.fromPickle(pkl);
-  if(Trace.isOn("showSharing") && Options::currentGetThreadId() == 0) {
-    (*Options::currentGetOut()) << "thread #0: getNewLemma: " << e << std::endl;
+Result CubeQueue::getResult() {
+  boost::lock_guard<boost::mutex> lock(d_mutex);
+  if(d_winner >= 0) {
+    return Result(Result::SAT);
+  }
+  if(d_numUnsat == d_numCubes) {
+    return Result(Result::UNSAT);
   }
-  return e;
+  if(!d_unknown.isNull()) {
+    return Result(Result::SAT_UNKNOWN, d_unknown.whyUnknown());
+  }
+  return Result(Result::SAT_UNKNOWN, Result::INCOMPLETE);
 }
 
+int CubeQueue::getWinner() {
+  boost::lock_guard<boost::mutex> lock(d_mutex);
+  return d_winner;
+}
+
+bool solveCubes(unsigned thread,
+                SmtEngine* smt,
+                const std::vector<Expr>* atoms,
+                CubeQueue* queue) {
+  unsigned cube;
+  while(queue->next(cube)) {
+    std::vector<Expr> assumptions;
+    for(unsigned j = 0; j < atoms->size(); ++j) {
+      assumptions.push_back(((cube >> j) & 1) ? (*atoms)[j]
+                                              : (*atoms)[j].notExpr());
+    }
+    Result result;
+    try {
+      result = smt->checkSat(assumptions);
+    } catch(Exception& e) {
+      Notice() << "thread #" << thread << ": cube " << cube << " failed: "
+               << e.getMessage() << std::endl;
+      result = Result(Result::SAT_UNKNOWN, Result::OTHER);
+    }
+    queue->report(thread, cube, result);
+  }
+  return true;
+}
+
+void sharingManager(unsigned numThreads, SmtEngine* smts[])
+{
+  Trace("sharing") << "sharing: thread started " << std::endl;
+
+  const unsigned int sharingBroadcastInterval = 1;
+
+  /* Disable interruption, so that we can check manually */
+  boost::this_thread::disable_interruption di;
+
+  while(not boost::this_thread::interruption_requested()) {
+    boost::this_thread::sleep
+      (boost::posix_time::milliseconds(sharingBroadcastInterval));
+  }
+
+  Trace("interrupt")
+    << "sharing thread interrupted, interrupting all smtEngines" << std::endl;
+
+  for(unsigned t = 0; t < numThreads; ++t) {
+    Trace("interrupt") << "Interrupting thread #" << t << std::endl;
+    try{
+      smts[t]->interrupt();
+    }catch(ModalException &e){
+      // It's fine, the thread is probably not there.
+      Trace("interrupt") << "Could not interrupt thread #" << t << std::endl;
+    }
+  }
+
+  Trace("sharing") << "sharing: Interrupted, exiting." << std::endl;
+}/* sharingManager() */
+
 }/*CVC4 namespace */
@@ -15,62 +15,152 @@
 #ifndef CVC4__PORTFOLIO_UTIL_H
 #define CVC4__PORTFOLIO_UTIL_H
 
-#include <queue>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
 
 #include "base/output.h"
 #include "expr/pickler.h"
 #include "smt/smt_engine.h"
-#include "smt_util/lemma_input_channel.h"
-#include "smt_util/lemma_output_channel.h"
-#include "util/channel.h"
+#include "smt_util/clause_sharing_channel.h"
 
 namespace CVC4 {
 
-typedef expr::pickle::Pickle ChannelFormat;
+/**
+ * A fixed-size ring buffer of short clauses over shared literals, written and
+ * read by all the portfolio threads without locks.
+ *
+ * A producer claims the next ticket with an atomic increment and fills the
+ * slot of that ticket. The sequence number of a slot is odd while it is being
+ * written and 2 * ticket + 2 once it holds the clause of ticket. Each consumer
+ * has its own read position; it copies a slot and then re-reads the sequence
+ * number to detect that the slot was overwritten in the meantime. Nobody ever
+ * waits: a producer that finds its slot busy drops its clause, and a consumer
+ * that falls more than the capacity behind skips the lost clauses.
+ */
+class SharedClauseBuffer {
+ public:
+  /** Longer clauses are not shared. */
+  static const unsigned s_maxClauseSize = 32;
 
-class PortfolioLemmaOutputChannel : public LemmaOutputChannel {
-private:
-  std::string d_tag;
-  SharedChannel<ChannelFormat>* d_sharedChannel;
-  expr::pickle::MapPickler d_pickler;
+  SharedClauseBuffer(size_t capacity);
+
+  /** Publish a clause of the given thread. Returns false if it was dropped. */
+  bool push(unsigned producer, const std::vector<uint32_t>& lits);
+
+  /**
+   * Get the next clause not published by consumer, starting at the ticket
+   * pos (which is advanced). Returns false if there are none.
+   */
+  bool pop(unsigned consumer, uint64_t& pos, std::vector<uint32_t>& lits);
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> d_seq;
+    std::atomic<uint32_t> d_producer;
+    std::atomic<uint32_t> d_size;
+    std::atomic<uint32_t> d_lits[s_maxClauseSize];
+  };
+
+  std::vector<Slot> d_slots;
+  std::atomic<uint64_t> d_head;
+};/* class SharedClauseBuffer */
+
+/**
+ * The common numbering of the atoms shared between the portfolio threads. An
+ * atom is identified by its pickle, which maps the variables to the ones of
+ * the first thread. Each thread asks for an atom at most once, so a lock is
+ * fine here.
+ */
+class SharedAtomTable {
+ public:
+  /** Get the identifier of the atom with the given pickle. */
+  uint32_t getId(const expr::pickle::Pickle& atom);
 
-public:
-  int cnt;
-  PortfolioLemmaOutputChannel(std::string tag,
-                              SharedChannel<ChannelFormat> *c,
-                              ExprManager* em,
-                              VarMap& to,
-                              VarMap& from) :
-    d_tag(tag),
-    d_sharedChannel(c),
-    d_pickler(em, to, from),
-    cnt(0)
-  {}
-
-  ~PortfolioLemmaOutputChannel() {}
-
-  void notifyNewLemma(Expr lemma) override;
-};/* class PortfolioLemmaOutputChannel */
-
-class PortfolioLemmaInputChannel : public LemmaInputChannel {
-private:
+  /** Get the pickle of the given atom. */
+  expr::pickle::Pickle getAtom(uint32_t id);
+
+ private:
+  boost::mutex d_mutex;
+  std::unordered_map<std::string, uint32_t> d_ids;
+  std::vector<expr::pickle::Pickle> d_atoms;
+};/* class SharedAtomTable */
+
+class PortfolioClauseSharingChannel : public ClauseSharingChannel {
+ private:
   std::string d_tag;
-  SharedChannel<ChannelFormat>* d_sharedChannel;
+  unsigned d_threadId;
+  SharedClauseBuffer* d_buffer;
+  SharedAtomTable* d_atoms;
   expr::pickle::MapPickler d_pickler;
+  /** Next ticket to read from d_buffer */
+  uint64_t d_readPos;
 
-public:
-  PortfolioLemmaInputChannel(std::string tag,
-                             SharedChannel<ChannelFormat>* c,
-                             ExprManager* em,
-                             VarMap& to,
-                               VarMap& from);
+ public:
+  PortfolioClauseSharingChannel(std::string tag,
+                                unsigned threadId,
+                                SharedClauseBuffer* buffer,
+                                SharedAtomTable* atoms,
+                                ExprManager* em,
+                                VarMap& to,
+                                VarMap& from);
+
+  bool getAtomId(Expr atom, uint32_t& id) override;
+  Expr getAtom(uint32_t id) override;
+  void exportClause(const std::vector<uint32_t>& lits) override;
+  bool importClause(std::vector<uint32_t>& lits) override;
+};/* class PortfolioClauseSharingChannel */
+
+/**
+ * The cubes of a cube-and-conquer check-sat, handed out to the portfolio
+ * threads one at a time. Cube c gives split atom j the value of bit j of c.
+ * The results are merged as they come in: the first satisfiable cube
+ * interrupts all the threads, and the query is unsatisfiable once all the
+ * cubes are.
+ */
+class CubeQueue {
+ public:
+  CubeQueue(const std::vector<SmtEngine*>& smts, unsigned numAtoms);
+
+  /**
+   * Get the next cube to solve. Returns false if there are none left, or if
+   * a satisfiable cube was found.
+   */
+  bool next(unsigned& cube);
 
-  ~PortfolioLemmaInputChannel() {}
+  /** Report the result of the given thread on one of its cubes. */
+  void report(unsigned thread, unsigned cube, const Result& result);
 
-  bool hasNewLemma() override;
-  Expr getNewLemma() override;
+  /** The merged result, once no thread is solving a cube any more. */
+  Result getResult();
 
-};/* class PortfolioLemmaInputChannel */
+  /** The thread that found a satisfiable cube, or -1 if there is none. */
+  int getWinner();
+
+ private:
+  boost::mutex d_mutex;
+  std::vector<SmtEngine*> d_smts;
+  unsigned d_numCubes;
+  unsigned d_nextCube;
+  unsigned d_numUnsat;
+  int d_winner;
+  /** The first unknown result of a cube, if any */
+  Result d_unknown;
+};/* class CubeQueue */
+
+/**
+ * Solve cubes of queue with the given thread, which must be in incremental
+ * mode, until there are none left. The atoms are in the expression manager
+ * of the thread.
+ */
+bool solveCubes(unsigned thread,
+                SmtEngine* smt,
+                const std::vector<Expr>* atoms,
+                CubeQueue* queue);
 
 class OptionsList {
  public:
@@ -93,87 +183,12 @@ class OptionsList {
 
 void parseThreadSpecificOptions(OptionsList& list, const Options& opts);
 
-template<typename T>
-void sharingManager(unsigned numThreads,
-                    SharedChannel<T> *channelsOut[], // out and in with respect
-                    SharedChannel<T> *channelsIn[],
-                    SmtEngine *smts[])  // to smt engines
-{
-  Trace("sharing") << "sharing: thread started " << std::endl;
-  std::vector <int> cnt(numThreads); // Debug("sharing")
-
-  std::vector< std::queue<T> > queues;
-  for(unsigned i = 0; i < numThreads; ++i){
-    queues.push_back(std::queue<T>());
-  }
-
-  const unsigned int sharingBroadcastInterval = 1;
-
-  boost::mutex mutex_activity;
-
-  /* Disable interruption, so that we can check manually */
-  boost::this_thread::disable_interruption di;
-
-  while(not boost::this_thread::interruption_requested()) {
-
-    boost::this_thread::sleep
-      (boost::posix_time::milliseconds(sharingBroadcastInterval));
-
-    for(unsigned t = 0; t < numThreads; ++t) {
-
-      /* No activity on this channel */
-      if(channelsOut[t]->empty()) continue;
-
-      /* Alert if channel full, so that we increase sharingChannelSize
-         or decrease sharingBroadcastInterval */
-      assert(not channelsOut[t]->full());
-
-      T data = channelsOut[t]->pop();
-
-      if(Trace.isOn("sharing")) {
-        ++cnt[t];
-        Trace("sharing") << "sharing: Got data. Thread #" << t
-                         << ". Chunk " << cnt[t] << std::endl;
-      }
-
-      for(unsigned u = 0; u < numThreads; ++u) {
-        if(u != t){
-          Trace("sharing") << "sharing: adding to queue " << u << std::endl;
-          queues[u].push(data);
-        }
-      }/* end of inner for: broadcast activity */
-
-    } /* end of outer for: look for activity */
-
-    for(unsigned t = 0; t < numThreads; ++t){
-      /* Alert if channel full, so that we increase sharingChannelSize
-         or decrease sharingBroadcastInterval */
-      assert(not channelsIn[t]->full());
-
-      while(!queues[t].empty() && !channelsIn[t]->full()){
-        Trace("sharing") << "sharing: pushing on channel " << t << std::endl;
-        T data = queues[t].front();
-        channelsIn[t]->push(data);
-        queues[t].pop();
-      }
-    }
-  } /* end of infinite while */
-
-  Trace("interrupt")
-    << "sharing thread interrupted, interrupting all smtEngines" << std::endl;
-
-  for(unsigned t = 0; t < numThreads; ++t) {
-    Trace("interrupt") << "Interrupting thread #" << t << std::endl;
-    try{
-      smts[t]->interrupt();
-    }catch(ModalException &e){
-      // It's fine, the thread is probably not there.
-      Trace("interrupt") << "Could not interrupt thread #" << t << std::endl;
-    }
-  }
-
-  Trace("sharing") << "sharing: Interrupted, exiting." << std::endl;
-}/* sharingManager() */
+/**
+ * Body of the sharing manager thread. Learned clauses are exchanged by the
+ * SAT solvers themselves; this thread waits to be interrupted and then
+ * interrupts all the smt engines.
+ */
+void sharingManager(unsigned numThreads, SmtEngine* smts[]);
 
 }/* CVC4 namespace */
 
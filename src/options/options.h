@@ -241,6 +241,7 @@ public:
   std::ostream* getOutConst() const; // TODO: Remove this.
   std::string getBinaryName() const;
   std::string getReplayInputFilename() const;
+  unsigned getCubeDepth() const;
   unsigned getParseStep() const;
   unsigned getThreadStackSize() const;
   unsigned getThreads() const;
@@ -215,6 +215,10 @@ std::string Options::getReplayInputFilename() const{
   return (*this)[options::replayInputFilename];
 }
 
+unsigned Options::getCubeDepth() const{
+  return (*this)[options::cubeDepth];
+}
+
 unsigned Options::getParseStep() const{
   return (*this)[options::parseStep];
 }
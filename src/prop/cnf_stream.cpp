@@ -24,6 +24,7 @@
 #include "expr/expr.h"
 #include "expr/node.h"
 #include "options/bv_options.h"
+#include "options/prop_options.h"
 #include "proof/clause_id.h"
 #include "proof/cnf_proof.h"
 #include "proof/proof_manager.h"
@@ -118,6 +119,19 @@ void CnfStream::assertClause(TNode node, SatLiteral a, SatLiteral b, SatLiteral
   assertClause(node, clause);
 }
 
+void CnfStream::assertXorClause(TNode node, SatClause& c, bool rhs) {
+  Debug("cnf") << "Inserting into stream xor " << c << " = " << rhs
+               << " node = " << node << endl;
+  Assert(useNativeXor());
+  d_satSolver->addXorClause(c, rhs, d_removable);
+}
+
+bool CnfStream::useNativeXor() const {
+  // Dumped clauses and proofs need the clausal expansion
+  return options::satXor() && d_satSolver->nativeXor() && !PROOF_ON()
+         && !Dump.isOn("clauses");
+}
+
 bool CnfStream::hasLiteral(TNode n) const {
   NodeToLiteralMap::const_iterator find = d_nodeToLiteralMap.find(n);
   return find != d_nodeToLiteralMap.end();
@@ -271,12 +285,85 @@ SatLiteral CnfStream::getLiteral(TNode node) {
   return literal;
 }
 
+namespace {
+/** Returns true if node continues an XOR chain (see collectXorChain()) */
+bool isXorChainNode(TNode node)
+{
+  return node.getKind() == XOR || node.getKind() == NOT
+         || (node.getKind() == EQUAL && node[0].getType().isBoolean());
+}
+}  // namespace
+
+void TseitinCnfStream::collectXorChain(TNode node,
+                                       std::vector<TNode>& leaves,
+                                       bool& rhs) {
+  Assert(isXorChainNode(node));
+  // (a = b) is the same as !(a XOR b)
+  if (node.getKind() != XOR) {
+    rhs = !rhs;
+  }
+  for (const TNode& child : node) {
+    // Reuse the children that are already translated
+    if (!hasLiteral(child) && isXorChainNode(child)) {
+      collectXorChain(child, leaves, rhs);
+    } else {
+      leaves.push_back(child);
+    }
+  }
+}
+
+bool TseitinCnfStream::convertAndAssertXorChain(TNode node, bool negated) {
+  if (d_removable || !useNativeXor()) {
+    return false;
+  }
+  std::vector<TNode> leaves;
+  bool rhs = !negated;
+  collectXorChain(node, leaves, rhs);
+  // Short chains are better off as clauses
+  if (leaves.size() < 3) {
+    return false;
+  }
+  SatClause clause(leaves.size());
+  for (unsigned i = 0; i < leaves.size(); ++i) {
+    clause[i] = toCNF(leaves[i]);
+  }
+  assertXorClause(negated ? node.negate() : Node(node), clause, rhs);
+  return true;
+}
+
+SatLiteral TseitinCnfStream::handleXorChain(TNode node) {
+  if (d_removable || !useNativeXor()) {
+    return undefSatLiteral;
+  }
+  std::vector<TNode> leaves;
+  bool rhs = false;
+  collectXorChain(node, leaves, rhs);
+  if (leaves.size() < 3) {
+    return undefSatLiteral;
+  }
+  SatClause clause(leaves.size() + 1);
+  for (unsigned i = 0; i < leaves.size(); ++i) {
+    clause[i] = toCNF(leaves[i]);
+  }
+  // lit <-> (a_1 XOR ... XOR a_n XOR rhs)
+  // lit XOR a_1 XOR ... XOR a_n = rhs
+  SatLiteral xorLit = newLiteral(node);
+  clause[leaves.size()] = xorLit;
+  assertXorClause(node, clause, rhs);
+  return xorLit;
+}
+
 SatLiteral TseitinCnfStream::handleXor(TNode xorNode) {
   Assert(!hasLiteral(xorNode), "Atom already mapped!");
   Assert(xorNode.getKind() == XOR, "Expecting an XOR expression!");
   Assert(xorNode.getNumChildren() == 2, "Expecting exactly 2 children!");
   Assert(!d_removable, "Removable clauses can not contain Boolean structure");
 
+  SatLiteral xorChainLit = handleXorChain(xorNode);
+  if (xorChainLit != undefSatLiteral) {
+    return xorChainLit;
+  }
+
   SatLiteral a = toCNF(xorNode[0]);
   SatLiteral b = toCNF(xorNode[1]);
 
@@ -397,6 +484,11 @@ SatLiteral TseitinCnfStream::handleIff(TNode iffNode) {
 
   Debug("cnf") << "handleIff(" << iffNode << ")" << endl;
 
+  SatLiteral xorChainLit = handleXorChain(iffNode);
+  if (xorChainLit != undefSatLiteral) {
+    return xorChainLit;
+  }
+
   // Convert the children to CNF
   SatLiteral a = toCNF(iffNode[0]);
   SatLiteral b = toCNF(iffNode[1]);
@@ -571,6 +663,9 @@ void TseitinCnfStream::convertAndAssertOr(TNode node, bool negated) {
 }
 
 void TseitinCnfStream::convertAndAssertXor(TNode node, bool negated) {
+  if (convertAndAssertXorChain(node, negated)) {
+    return;
+  }
   if (!negated) {
     // p XOR q
     SatLiteral p = toCNF(node[0], false);
@@ -601,6 +696,9 @@ void TseitinCnfStream::convertAndAssertXor(TNode node, bool negated) {
 }
 
 void TseitinCnfStream::convertAndAssertIff(TNode node, bool negated) {
+  if (convertAndAssertXorChain(node, negated)) {
+    return;
+  }
   if (!negated) {
     // p <=> q
     SatLiteral p = toCNF(node[0], false);
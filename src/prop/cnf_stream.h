@@ -154,6 +154,21 @@ class CnfStream {
    */
   void assertClause(TNode node, SatLiteral a, SatLiteral b, SatLiteral c);
 
+  /**
+   * Asserts the XOR constraint that the literals of the clause sum up to rhs
+   * (modulo 2) to the sat solver. Only valid if useNativeXor() is true.
+   * @param node the node giving rise to this constraint
+   * @param clause the literals of the constraint
+   * @param rhs the parity of the constraint
+   */
+  void assertXorClause(TNode node, SatClause& clause, bool rhs);
+
+  /**
+   * Returns true if XOR chains should be handed to the sat solver as native
+   * XOR constraints instead of being expanded into clauses.
+   */
+  bool useNativeXor() const;
+
   /**
    * Acquires a new variable from the SAT solver to represent the node
    * and inserts the necessary data it into the mapping tables.
@@ -323,6 +338,30 @@ class TseitinCnfStream : public CnfStream {
   void convertAndAssertImplies(TNode node, bool negated);
   void convertAndAssertIte(TNode node, bool negated);
 
+  /**
+   * Collects the leaves of the XOR chain rooted at node, i.e. the maximal
+   * subterms reachable through XORs, Boolean equalities and negations that
+   * are not translated yet. The parity of the negations and equalities
+   * passed on the way is accumulated into rhs, so that node is equivalent
+   * to the XOR of the leaves and rhs.
+   */
+  void collectXorChain(TNode node, std::vector<TNode>& leaves, bool& rhs);
+
+  /**
+   * Asserts the XOR chain rooted at node as a single native XOR constraint.
+   * Returns false (without asserting anything) if native XOR constraints are
+   * not used or the chain is too short to benefit from them.
+   */
+  bool convertAndAssertXorChain(TNode node, bool negated);
+
+  /**
+   * Defines a new literal for the XOR chain rooted at node with a single
+   * native XOR constraint. Returns undefSatLiteral (without defining
+   * anything) if native XOR constraints are not used or the chain is too
+   * short to benefit from them.
+   */
+  SatLiteral handleXorChain(TNode node);
+
   /**
    * Transforms the node into CNF recursively.
    * @param node the formula to transform
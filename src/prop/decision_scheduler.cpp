@@ -0,0 +1,98 @@
+/*********************                                                        */
+/*! \file decision_scheduler.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Scheduling of the decision sources of the SAT solver.
+ **
+ ** Implementation of the weighted decision source scheduler.
+ **/
+
+#include "prop/decision_scheduler.h"
+
+#include <iostream>
+
+#include "base/cvc4_assert.h"
+
+namespace CVC4 {
+namespace prop {
+
+DecisionScheduler::DecisionScheduler() : d_total(0)
+{
+  for (unsigned i = 0; i < NUM_SOURCES; ++i)
+  {
+    d_weight[i] = 0;
+    d_credit[i] = 0;
+  }
+}
+
+void DecisionScheduler::setWeight(Source source, unsigned weight)
+{
+  Assert(source < NUM_SOURCES);
+  if (d_weight[source] == weight)
+  {
+    return;
+  }
+  d_total = d_total - d_weight[source] + weight;
+  d_weight[source] = weight;
+  for (unsigned i = 0; i < NUM_SOURCES; ++i)
+  {
+    d_credit[i] = 0;
+  }
+}
+
+void DecisionScheduler::nextOrder(Source order[NUM_SOURCES])
+{
+  for (unsigned i = 0; i < NUM_SOURCES; ++i)
+  {
+    order[i] = Source(i);
+  }
+  if (!enabled())
+  {
+    return;
+  }
+
+  // Every source earns its weight, the richest one goes first and pays for
+  // everybody
+  unsigned best = NUM_SOURCES;
+  for (unsigned i = 0; i < NUM_SOURCES; ++i)
+  {
+    if (d_weight[i] == 0)
+    {
+      continue;
+    }
+    d_credit[i] += d_weight[i];
+    if (best == NUM_SOURCES || d_credit[i] > d_credit[best])
+    {
+      best = i;
+    }
+  }
+  Assert(best < NUM_SOURCES);
+  d_credit[best] -= d_total;
+
+  // The picked source first, then the others in the default order
+  for (unsigned i = best; i > 0; --i)
+  {
+    order[i] = order[i - 1];
+  }
+  order[0] = Source(best);
+}
+
+std::ostream& operator<<(std::ostream& out, DecisionScheduler::Source source)
+{
+  switch (source)
+  {
+    case DecisionScheduler::THEORY: out << "THEORY"; break;
+    case DecisionScheduler::ENGINE: out << "ENGINE"; break;
+    case DecisionScheduler::ACTIVITY: out << "ACTIVITY"; break;
+    default: out << "DecisionScheduler::Source!UNKNOWN"; break;
+  }
+  return out;
+}
+
+}  // namespace prop
+}  // namespace CVC4
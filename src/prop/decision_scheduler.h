@@ -0,0 +1,75 @@
+/*********************                                                        */
+/*! \file decision_scheduler.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Scheduling of the decision sources of the SAT solver.
+ **
+ ** The SAT solver takes its decisions from several sources: the theories, the
+ ** decision engine (e.g. the justification heuristic) and its own activity
+ ** heuristic. The scheduler decides which source is asked first.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PROP__DECISION_SCHEDULER_H
+#define CVC4__PROP__DECISION_SCHEDULER_H
+
+#include <cstdint>
+#include <iosfwd>
+
+namespace CVC4 {
+namespace prop {
+
+/**
+ * Interleaves the decision sources by weight, using smooth weighted
+ * round-robin: with weights 2, 1 and 1 the sources are asked first in the
+ * order A, B, A, C, A, B, ... The sources that were not picked are asked
+ * afterwards in the default order (theory, engine, activity), so no source is
+ * starved when the preferred one has nothing to decide.
+ *
+ * If all the weights are 0 (the default) the scheduler is disabled and the
+ * default order is used for every decision.
+ */
+class DecisionScheduler
+{
+ public:
+  enum Source
+  {
+    THEORY = 0,
+    ENGINE,
+    ACTIVITY,
+    NUM_SOURCES
+  };
+
+  DecisionScheduler();
+
+  /** Set the weight of a source. */
+  void setWeight(Source source, unsigned weight);
+
+  /** Is any of the weights non-zero? */
+  bool enabled() const { return d_total > 0; }
+
+  /**
+   * Get the order in which to ask the sources for the next decision, most
+   * preferred first.
+   */
+  void nextOrder(Source order[NUM_SOURCES]);
+
+ private:
+  unsigned d_weight[NUM_SOURCES];
+  /** Current credit of each source (smooth weighted round-robin) */
+  int64_t d_credit[NUM_SOURCES];
+  unsigned d_total;
+}; /* class DecisionScheduler */
+
+std::ostream& operator<<(std::ostream& out, DecisionScheduler::Source source);
+
+}  // namespace prop
+}  // namespace CVC4
+
+#endif /* CVC4__PROP__DECISION_SCHEDULER_H */
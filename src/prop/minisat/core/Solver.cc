@@ -22,10 +22,13 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include <math.h>
 
+#include <algorithm>
 #include <iostream>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "base/output.h"
+#include "options/decision_options.h"
 #include "options/main_options.h"
 #include "options/prop_options.h"
 #include "options/smt_options.h"
@@ -35,6 +38,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "proof/sat_proof_implementation.h"
 #include "prop/minisat/minisat.h"
 #include "prop/minisat/mtl/Sort.h"
+#include "prop/sat_local_search.h"
 #include "prop/theory_proxy.h"
 
 using namespace CVC4::prop;
@@ -75,6 +79,9 @@ static IntOption     opt_restart_first     (_cat, "rfirst",      "The base resta
 static DoubleOption  opt_restart_inc       (_cat, "rinc",        "Restart interval increase factor", 3, DoubleRange(1, false, HUGE_VAL, false));
 static DoubleOption  opt_garbage_frac      (_cat, "gc-frac",     "The fraction of wasted memory allowed before a garbage collection is triggered",  0.20, DoubleRange(0, false, HUGE_VAL, false));
 
+// Maximal size (in 64-bit words) of the XOR matrix for Gauss-Jordan elimination
+static const size_t xor_gauss_max_words = 1 << 20;
+
 //=================================================================================================
 // Proof declarations
 CRef Solver::TCRef_Undef = CRef_Undef;
@@ -132,6 +139,9 @@ Solver::Solver(CVC4::prop::TheoryProxy* proxy, CVC4::context::Context* context,
     //
   , solves(0), starts(0), decisions(0), rnd_decisions(0), propagations(0), conflicts(0), resources_consumed(0)
   , dec_vars(0), clauses_literals(0), learnts_literals(0), max_literals(0), tot_literals(0)
+  , xor_constraints(0), xor_propagations(0), xor_conflicts(0), xor_gauss_implied(0)
+  , sls_calls(0), sls_flips(0), sls_models(0)
+  , theory_decisions(0), engine_decisions(0), activity_decisions(0), restored_activities(0)
 
   , ok                 (true)
   , cla_inc            (1)
@@ -143,6 +153,8 @@ Solver::Solver(CVC4::prop::TheoryProxy* proxy, CVC4::context::Context* context,
   , order_heap         (VarOrderLt(activity))
   , progress_estimate  (0)
   , remove_satisfied   (!enable_incremental)
+  , xors_dirty         (false)
+  , activity_restored_vars (0)
 
     // Resource constraints:
     //
@@ -194,6 +206,9 @@ Var Solver::newVar(bool sign, bool dvar, bool isTheoryAtom, bool preRegister, bo
     decision .push();
     trail    .capacity(v+1);
     theory   .push(isTheoryAtom);
+    xor_watches.push();
+    xor_reason.push(-1);
+    xor_reason_cache.push(CRef_Undef);
 
     setDecisionVar(v, dvar);
 
@@ -225,6 +240,9 @@ void Solver::resizeVars(int newSize) {
     polarity.shrink(shrinkSize);
     decision.shrink(shrinkSize);
     theory.shrink(shrinkSize);
+    xor_watches.shrink(shrinkSize);
+    xor_reason.shrink(shrinkSize);
+    xor_reason_cache.shrink(shrinkSize);
 
   }
 
@@ -241,6 +259,14 @@ CRef Solver::reason(Var x) {
   // If we already have a reason, just return it
   if (vardata[x].reason != CRef_Lazy) return vardata[x].reason;
 
+  // XOR propagations are explained by the propagating constraint
+  if (xor_reason[x] != -1)
+  {
+    CRef xor_reason_clause = xorClause(xor_reason[x], x);
+    vardata[x] = VarData(xor_reason_clause, level(x), user_level(x), intro_level(x), trail_index(x));
+    return xor_reason_clause;
+  }
+
   // What's the literal we are trying to explain
   Lit l = mkLit(x, value(x) != l_True);
 
@@ -493,6 +519,297 @@ bool Solver::addClause_(vec<Lit>& ps, bool removable, ClauseId& id)
     return true;
 }
 
+bool Solver::addXorClause(const vec<Var>& vs, bool rhs)
+{
+    if (!ok) return false;
+
+    // Cancel out repeated variables and fold in the values of the variables
+    // fixed at 0 level (both sat and user level)
+    std::vector<Var> sorted;
+    for (int i = 0; i < vs.size(); i++) sorted.push_back(vs[i]);
+    std::sort(sorted.begin(), sorted.end());
+
+    std::vector<Var> vars;
+    int xorLevel = assertionLevel;
+    for (size_t i = 0; i < sorted.size(); ) {
+      if (i + 1 < sorted.size() && sorted[i] == sorted[i + 1]) {
+        // x xor x = 0
+        i += 2;
+        continue;
+      }
+      Var v = sorted[i++];
+      if (value(v) != l_Undef && level(v) == 0 && user_level(v) == 0) {
+        rhs ^= (value(v) == l_True);
+        continue;
+      }
+      if (!assertionLevelOnly()) {
+        xorLevel = std::max(xorLevel, intro_level(v));
+      }
+      vars.push_back(v);
+    }
+
+    Debug("minisat") << "Solver::addXorClause(): " << vars.size()
+                     << " variables, rhs " << rhs << std::endl;
+
+    // Empty and unit constraints are just clauses
+    if (vars.size() < 2) {
+      if (vars.size() == 0 && !rhs) return true;
+      add_tmp.clear();
+      if (vars.size() == 1) add_tmp.push(mkLit(vars[0], !rhs));
+      ClauseId id;
+      return addClause_(add_tmp, false, id);
+    }
+
+    // If we are in solve_ or propagate, attach it with the lemmas
+    if (minisat_busy) {
+      xors_pending.push_back(XorConstraint(vars, rhs, xorLevel));
+      return true;
+    }
+
+    assert(decisionLevel() == 0);
+    xors.push_back(XorConstraint(vars, rhs, xorLevel));
+    xor_constraints++;
+    xors_dirty = true;
+    if (attachXor(xors.size() - 1) != CRef_Undef) {
+      return ok = false;
+    }
+    return ok = (propagate(CHECK_WITHOUT_THEORY) == CRef_Undef);
+}
+
+CRef Solver::attachXor(int index)
+{
+    std::vector<Var>& vs = xors[index].vars;
+    Assert(vs.size() > 1);
+
+    sortXorWatches(vs);
+    xor_watches[vs[0]].push(index);
+    xor_watches[vs[1]].push(index);
+
+    if (vs.size() == 2) {
+      xor_binaries.insert(xorBinaryKey(vs[0], vs[1], xors[index].rhs));
+    }
+
+    // If at most one variable is unassigned the constraint propagates or
+    // is in conflict
+    if (value(vs[1]) != l_Undef) {
+      bool parity = xors[index].rhs;
+      for (size_t k = 1; k < vs.size(); k++) {
+        parity ^= (value(vs[k]) == l_True);
+      }
+      if (value(vs[0]) == l_Undef) {
+        uncheckedEnqueue(mkLit(vs[0], !parity), CRef_Lazy);
+        xor_reason[vs[0]] = index;
+        xor_propagations++;
+      } else if (parity != (value(vs[0]) == l_True)) {
+        xor_conflicts++;
+        return xorClause(index, var_Undef);
+      }
+    }
+    return CRef_Undef;
+}
+
+void Solver::sortXorWatches(std::vector<Var>& vs) const
+{
+    // Unassigned variables go up front, the rest by decreasing trail index so
+    // that the watches are the last to be unassigned on backtracking
+    std::sort(vs.begin(), vs.end(), [this](Var x, Var y) {
+      if (value(x) == l_Undef || value(y) == l_Undef) {
+        return value(x) == l_Undef && value(y) != l_Undef;
+      }
+      return trail_index(x) > trail_index(y);
+    });
+}
+
+bool Solver::xorReasonValid(CRef cr, Var implied) const
+{
+    const Clause& c = ca[cr];
+    if (c.mark() != 0 || c.size() == 0 || var(c[0]) != implied || value(c[0]) != l_True)
+      return false;
+    for (int k = 1; k < c.size(); k++)
+      if (value(c[k]) != l_False) return false;
+    return true;
+}
+
+CRef Solver::xorClause(int index, Var implied)
+{
+    const XorConstraint& x = xors[index];
+
+    // The variable may have been propagated the same way before
+    if (implied != var_Undef && xor_reason_cache[implied] != CRef_Undef) {
+      CRef cached = xor_reason_cache[implied];
+      if (xorReasonValid(cached, implied)) {
+        return cached;
+      }
+    }
+
+    // Every variable is assigned, take the literals falsified by the current
+    // assignment, except for the implied one
+    vec<Lit> lits;
+    int clauseLevel = assertionLevelOnly() ? assertionLevel : x.level;
+    for (size_t k = 0; k < x.vars.size(); k++) {
+      Var u = x.vars[k];
+      Assert(value(u) != l_Undef);
+      Lit l = mkLit(u, value(u) == l_True);
+      lits.push(u == implied ? ~l : l);
+      if (!assertionLevelOnly()) {
+        clauseLevel = std::max(clauseLevel, intro_level(u));
+      }
+    }
+
+    // Sort so that the implied literal comes first and the watches are the
+    // most recently assigned literals
+    lemma_lt lt(*this);
+    sort(lits, lt);
+    Assert(implied == var_Undef || var(lits[0]) == implied);
+
+    CRef cr = ca.alloc(clauseLevel, lits, true);
+    clauses_removable.push(cr);
+    attachClause(cr);
+    if (implied != var_Undef) {
+      xor_reason_cache[implied] = cr;
+    }
+    return cr;
+}
+
+void Solver::rebuildXorWatches()
+{
+    for (int v = 0; v < nVars(); v++) {
+      xor_watches[v].clear();
+    }
+    xor_binaries.clear();
+    for (size_t i = 0; i < xors.size(); i++) {
+      std::vector<Var>& vs = xors[i].vars;
+      sortXorWatches(vs);
+      xor_watches[vs[0]].push(i);
+      xor_watches[vs[1]].push(i);
+      if (vs.size() == 2) {
+        xor_binaries.insert(xorBinaryKey(vs[0], vs[1], xors[i].rhs));
+      }
+    }
+}
+
+/*_________________________________________________________________________________________________
+|
+|  xorGaussEliminate : [void]  ->  [bool]
+|
+|  Description:
+|    Runs Gauss-Jordan elimination over the XOR constraints, pivoting on the variables that are
+|    unassigned at level 0. The assigned variables are carried along, so that each row is an XOR
+|    constraint implied by the system. A row with a single unassigned variable is added as a new
+|    constraint, which propagates the variable with itself as the reason. Implied
+|    (in)equivalences between two variables are added as new binary XOR constraints. Returns
+|    false if the system is inconsistent.
+|________________________________________________________________________________________________@*/
+bool Solver::xorGaussEliminate()
+{
+    assert(decisionLevel() == 0);
+    xors_dirty = false;
+    if (!CVC4::options::satXorGauss() || xors.size() < 2) return true;
+
+    // Number the variables, the 'pivots' unassigned ones first
+    std::unordered_map<Var, size_t> column;
+    std::vector<Var> columnVar;
+    size_t pivots = 0;
+    for (int pass = 0; pass < 2; pass++) {
+      for (size_t i = 0; i < xors.size(); i++) {
+        const std::vector<Var>& vs = xors[i].vars;
+        for (size_t k = 0; k < vs.size(); k++) {
+          if ((value(vs[k]) == l_Undef) == (pass == 0) && column.find(vs[k]) == column.end()) {
+            column[vs[k]] = columnVar.size();
+            columnVar.push_back(vs[k]);
+          }
+        }
+      }
+      if (pass == 0) pivots = columnVar.size();
+    }
+    if (pivots == 0) return true;
+    size_t words = (columnVar.size() + 63) / 64;
+    if (xors.size() * words > xor_gauss_max_words) {
+      Debug("minisat::xor") << "Solver::xorGaussEliminate(): skipping "
+                            << xors.size() << "x" << columnVar.size()
+                            << " matrix" << std::endl;
+      return true;
+    }
+
+    // Build the matrix
+    std::vector<std::vector<uint64_t> > rows(xors.size(), std::vector<uint64_t>(words, 0));
+    std::vector<char> rhs(xors.size());
+    for (size_t i = 0; i < xors.size(); i++) {
+      const std::vector<Var>& vs = xors[i].vars;
+      for (size_t k = 0; k < vs.size(); k++) {
+        size_t c = column[vs[k]];
+        rows[i][c / 64] |= uint64_t(1) << (c % 64);
+      }
+      rhs[i] = xors[i].rhs;
+    }
+
+    // Reduce it to reduced row echelon form on the unassigned columns
+    size_t pivot = 0;
+    for (size_t c = 0; c < pivots && pivot < rows.size(); c++) {
+      size_t w = c / 64;
+      uint64_t bit = uint64_t(1) << (c % 64);
+      size_t r = pivot;
+      while (r < rows.size() && !(rows[r][w] & bit)) r++;
+      if (r == rows.size()) continue;
+      std::swap(rows[r], rows[pivot]);
+      std::swap(rhs[r], rhs[pivot]);
+      for (size_t r2 = 0; r2 < rows.size(); r2++) {
+        if (r2 != pivot && (rows[r2][w] & bit)) {
+          for (size_t k = w; k < words; k++) rows[r2][k] ^= rows[pivot][k];
+          rhs[r2] ^= rhs[pivot];
+        }
+      }
+      pivot++;
+    }
+
+    // Harvest the rows with at most two unassigned variables
+    for (size_t r = 0; r < rows.size(); r++) {
+      std::vector<Var> unassigned, assigned;
+      bool parity = rhs[r];
+      for (size_t w = 0; w < words && unassigned.size() < 3; w++) {
+        for (uint64_t bits = rows[r][w]; bits != 0; bits &= bits - 1) {
+          size_t c = w * 64 + __builtin_ctzll(bits);
+          if (c < pivots) {
+            unassigned.push_back(columnVar[c]);
+          } else {
+            assigned.push_back(columnVar[c]);
+            parity ^= (value(columnVar[c]) == l_True);
+          }
+        }
+      }
+      if (unassigned.empty()) {
+        if (parity) {
+          Debug("minisat::xor") << "Solver::xorGaussEliminate(): inconsistent" << std::endl;
+          return false;
+        }
+      } else if (unassigned.size() == 1) {
+        Lit p = mkLit(unassigned[0], !parity);
+        if (value(p) == l_False) return false;
+        if (value(p) != l_Undef) continue;
+        xor_gauss_implied++;
+        if (assigned.empty()) {
+          // A unit of the XOR system, like a unit clause it needs no reason
+          uncheckedEnqueue(p);
+          continue;
+        }
+        // The row propagates the variable and explains it
+        assigned.push_back(unassigned[0]);
+        xors.push_back(XorConstraint(assigned, rhs[r], assertionLevel));
+        xor_constraints++;
+        if (attachXor(xors.size() - 1) != CRef_Undef) return false;
+        Assert(value(p) == l_True);
+      } else if (unassigned.size() == 2) {
+        if (xor_binaries.count(xorBinaryKey(unassigned[0], unassigned[1], parity)) == 0) {
+          xors.push_back(XorConstraint(unassigned, parity, assertionLevel));
+          xor_constraints++;
+          xor_gauss_implied++;
+          if (attachXor(xors.size() - 1) != CRef_Undef) return false;
+        }
+      }
+    }
+
+    return true;
+}
 
 void Solver::attachClause(CRef cr) {
     const Clause& c = ca[cr];
@@ -530,6 +847,9 @@ void Solver::removeClause(CRef cr) {
     detachClause(cr);
     // Don't leave pointers to free'd memory!
     if (locked(c)) vardata[var(c[0])].reason = CRef_Undef;
+    if (c.removable() && xor_constraints > 0)
+        for (int k = 0; k < c.size(); k++)
+            if (xor_reason_cache[var(c[k])] == cr) xor_reason_cache[var(c[k])] = CRef_Undef;
     c.mark(1);
     ca.free(cr);
 }
@@ -599,8 +919,69 @@ Lit Solver::pickBranchLit()
     }
 #endif /* CVC4_REPLAY */
 
-    // Theory requests
-    nextLit = MinisatSatSolver::toMinisatLit(proxy->getNextTheoryDecisionRequest());
+    // Ask the theories, the decision engine and the activity heuristic in the
+    // order given by the scheduler (by default always in this order).
+    // Postponing a theory request is fine: the theories are asked again at
+    // the next decision, and before giving up on the search.
+    CVC4::prop::DecisionScheduler::Source order[CVC4::prop::DecisionScheduler::NUM_SOURCES];
+    decision_scheduler.nextOrder(order);
+    bool theoryAsked = false;
+    for (unsigned i = 0; i < CVC4::prop::DecisionScheduler::NUM_SOURCES; ++i) {
+        switch (order[i]) {
+        case CVC4::prop::DecisionScheduler::THEORY:
+            theoryAsked = true;
+            nextLit = pickTheoryLit();
+            if (nextLit != lit_Undef) {
+                theory_decisions++;
+                return nextLit;
+            }
+            break;
+        case CVC4::prop::DecisionScheduler::ENGINE: {
+            bool stopSearch = false;
+            nextLit = pickEngineLit(stopSearch);
+            if (stopSearch) {
+                // The search only stops once the theories have no requests
+                // left, they may be mandatory (e.g. cardinality splits)
+                if (!theoryAsked) {
+                    nextLit = pickTheoryLit();
+                    if (nextLit != lit_Undef) {
+                        theory_decisions++;
+                        return nextLit;
+                    }
+                }
+                return lit_Undef;
+            }
+            if (nextLit != lit_Undef) {
+                engine_decisions++;
+                return nextLit;
+            }
+            break;
+        }
+        case CVC4::prop::DecisionScheduler::ACTIVITY:
+            nextLit = pickActivityLit();
+            if (nextLit != lit_Undef) {
+                activity_decisions++;
+                return nextLit;
+            }
+            break;
+        default:
+            Unreachable();
+        }
+    }
+    return lit_Undef;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  pickTheoryLit : () -> [Lit]
+|
+|  Description:
+|    Return the next unassigned literal requested by the theories, or lit_Undef.
+|________________________________________________________________________________________________@*/
+Lit Solver::pickTheoryLit()
+{
+    Lit nextLit = MinisatSatSolver::toMinisatLit(proxy->getNextTheoryDecisionRequest());
     while (nextLit != lit_Undef) {
       if(value(var(nextLit)) == l_Undef) {
         Debug("theoryDecision")
@@ -618,10 +999,21 @@ Lit Solver::pickBranchLit()
     Debug("theoryDecision")
         << "getNextTheoryDecisionRequest(): decide on another literal"
         << std::endl;
+    return lit_Undef;
+}
+
 
-    // DE requests
-    bool stopSearch = false;
-    nextLit = MinisatSatSolver::toMinisatLit(proxy->getNextDecisionEngineRequest(stopSearch));
+/*_________________________________________________________________________________________________
+|
+|  pickEngineLit : (stopSearch : bool&) -> [Lit]
+|
+|  Description:
+|    Return the next literal requested by the decision engine, or lit_Undef. Sets 'stopSearch'
+|    if the decision engine wants the search to stop.
+|________________________________________________________________________________________________@*/
+Lit Solver::pickEngineLit(bool& stopSearch)
+{
+    Lit nextLit = MinisatSatSolver::toMinisatLit(proxy->getNextDecisionEngineRequest(stopSearch));
     if(stopSearch) {
       return lit_Undef;
     }
@@ -635,7 +1027,20 @@ Lit Solver::pickBranchLit()
         return nextLit;
       }
     }
+    return lit_Undef;
+}
 
+
+/*_________________________________________________________________________________________________
+|
+|  pickActivityLit : () -> [Lit]
+|
+|  Description:
+|    Return the next decision from the variable activity heuristic (with random decisions), or
+|    lit_Undef if all the relevant decision variables are assigned.
+|________________________________________________________________________________________________@*/
+Lit Solver::pickActivityLit()
+{
     Var next = var_Undef;
 
     // Random decision:
@@ -922,6 +1327,7 @@ void Solver::uncheckedEnqueue(Lit p, CRef from)
     assert(var(p) < nVars());
     assigns[var(p)] = lbool(!sign(p));
     vardata[var(p)] = VarData(from, decisionLevel(), assertionLevel, intro_level(var(p)), trail.size());
+    xor_reason[var(p)] = -1;
     trail.push_(p);
     if (theory[var(p)]) {
       // Enqueue to the theory
@@ -939,7 +1345,7 @@ CRef Solver::propagate(TheoryCheckType type)
     ScopedBool scoped_bool(minisat_busy, true);
 
     // Add lemmas that we're left behind
-    if (lemmas.size() > 0) {
+    if (lemmas.size() > 0 || !xors_pending.empty()) {
       confl = updateLemmas();
       if (confl != CRef_Undef) {
         return confl;
@@ -955,7 +1361,7 @@ CRef Solver::propagate(TheoryCheckType type)
       // if new lemmas are added)
       propagateTheory();
       // If there are lemmas (or conflicts) update them
-      if (lemmas.size() > 0) {
+      if (lemmas.size() > 0 || !xors_pending.empty()) {
         recheck = true;
         confl = updateLemmas();
         return confl;
@@ -981,12 +1387,12 @@ CRef Solver::propagate(TheoryCheckType type)
             // Pick up the theory propagated literals
             propagateTheory();
             // If there are lemmas (or conflicts) update them
-            if (lemmas.size() > 0) {
+            if (lemmas.size() > 0 || !xors_pending.empty()) {
               confl = updateLemmas();
             }
         } else {
           // Even though in conflict, we still need to discharge the lemmas
-          if (lemmas.size() > 0) {
+          if (lemmas.size() > 0 || !xors_pending.empty()) {
             // Remember the trail size
             int oldLevel = decisionLevel();
             // Update the lemmas
@@ -1122,6 +1528,13 @@ CRef Solver::propagateBool()
         NextClause:;
         }
         ws.shrink(i - j);
+
+        // Propagate the XOR constraints watching the variable
+        if (confl == CRef_Undef && xor_watches[var(p)].size() > 0) {
+            confl = propagateXor(var(p));
+            if (confl != CRef_Undef)
+                qhead = trail.size();
+        }
     }
     propagations += num_props;
     simpDB_props -= num_props;
@@ -1129,6 +1542,62 @@ CRef Solver::propagateBool()
     return confl;
 }
 
+/*_________________________________________________________________________________________________
+|
+|  propagateXor : (v : Var)  ->  [Clause*]
+|
+|  Description:
+|    Visits the XOR constraints watching the newly assigned variable 'v' and moves the watch to
+|    an unassigned variable. If there is none, the other watched variable is propagated with a
+|    lazily explained reason (see 'reason()'), or, if it is assigned too, the parity is checked and
+|    the conflicting constraint is returned as a clause.
+|________________________________________________________________________________________________@*/
+CRef Solver::propagateXor(Var v)
+{
+    CRef       confl = CRef_Undef;
+    vec<int>&  ws    = xor_watches[v];
+    int        i, j;
+
+    for (i = j = 0; i < ws.size(); i++){
+        int index = ws[i];
+        if (confl != CRef_Undef){
+            ws[j++] = index; continue; }
+
+        // Make sure the assigned variable is vars[1]
+        std::vector<Var>& vs = xors[index].vars;
+        if (vs[0] == v)
+            std::swap(vs[0], vs[1]);
+        Assert(vs[1] == v);
+
+        // Look for a new watch
+        bool moved = false;
+        for (size_t k = 2; k < vs.size(); k++)
+            if (value(vs[k]) == l_Undef){
+                std::swap(vs[1], vs[k]);
+                xor_watches[vs[1]].push(index);
+                moved = true;
+                break; }
+        if (moved) continue;
+
+        // Did not find watch -- the constraint is unit or fully assigned
+        ws[j++] = index;
+        bool parity = xors[index].rhs;
+        for (size_t k = 1; k < vs.size(); k++)
+            parity ^= (value(vs[k]) == l_True);
+        if (value(vs[0]) == l_Undef){
+            uncheckedEnqueue(mkLit(vs[0], !parity), CRef_Lazy);
+            xor_reason[vs[0]] = index;
+            xor_propagations++;
+        }else if (parity != (value(vs[0]) == l_True)){
+            xor_conflicts++;
+            confl = xorClause(index, var_Undef);
+        }
+    }
+    ws.shrink(i - j);
+
+    return confl;
+}
+
 
 /*_________________________________________________________________________________________________
 |
@@ -1222,6 +1691,11 @@ bool Solver::simplify()
     if (!ok || propagate(CHECK_WITHOUT_THEORY) != CRef_Undef)
         return ok = false;
 
+    // Derive the top-level consequences of the XOR constraints
+    if (xors_dirty)
+        if (!xorGaussEliminate() || propagate(CHECK_WITHOUT_THEORY) != CRef_Undef)
+            return ok = false;
+
     if (nAssigns() == simpDB_assigns || (simpDB_props > 0))
         return true;
 
@@ -1279,6 +1753,8 @@ lbool Solver::search(int nof_conflicts)
             // Analyze the conflict
             learnt_clause.clear();
             int max_level = analyze(confl, learnt_clause, backtrack_level);
+            if (proxy->shareClauses())
+                shareLearnt(learnt_clause, assertionLevelOnly() ? assertionLevel : max_level);
             cancelUntil(backtrack_level);
 
             // Assert the conflict clause and the asserting literal
@@ -1358,6 +1834,8 @@ lbool Solver::search(int nof_conflicts)
               // [mdeters] notify theory engine of restarts for deferred
               // theory processing
               proxy->notifyRestart();
+              if (proxy->shareClauses())
+                importSharedClauses();
               return l_Undef;
             }
 
@@ -1438,6 +1916,94 @@ double Solver::progressEstimate() const
 
  */
 
+/*_________________________________________________________________________________________________
+|
+|  localSearchPhases : ()  ->  [void]
+|
+|  Description:
+|    Runs local search on the original clauses that are not yet satisfied at level 0, starting
+|    from the current saved phases, and replaces the unlocked saved phases with the best
+|    assignment found. If that assignment satisfies all the clauses the following search will
+|    follow it without conflicts on the Boolean skeleton, so it only has to be confirmed by the
+|    theories (if there are any).
+|________________________________________________________________________________________________@*/
+void Solver::localSearchPhases()
+{
+    assert(decisionLevel() == 0);
+    sls_calls++;
+
+    SatLocalSearch sls(nVars());
+    std::vector<unsigned> lits;
+    for (int i = 0; i < clauses_persistent.size(); i++){
+        const Clause& c = ca[clauses_persistent[i]];
+        bool satisfied = false;
+        lits.clear();
+        for (int j = 0; j < c.size() && !satisfied; j++){
+            lbool v = value(c[j]);
+            if (v == l_True)
+                satisfied = true;
+            else if (v == l_Undef)
+                lits.push_back(toInt(c[j]));
+        }
+        if (!satisfied && !lits.empty())
+            sls.addClause(lits);
+    }
+
+    for (Var v = 0; v < nVars(); v++)
+        sls.setValue(v, value(v) != l_Undef ? value(v) == l_True : !(polarity[v] & 0x1));
+
+    bool sat = sls.run(options::satLocalSearchFlips());
+    sls_flips += sls.flips();
+    if (sat) sls_models++;
+    Debug("minisat::sls") << "local search: " << sls.flips() << " flips, "
+                          << sls.bestUnsat() << " clauses unsatisfied" << std::endl;
+
+    for (Var v = 0; v < nVars(); v++)
+        if (value(v) == l_Undef && (polarity[v] & 0x2) == 0)
+            polarity[v] = !sls.bestValue(v);
+}
+
+/*_________________________________________________________________________________________________
+|
+|  shareLearnt : (clause : const vec<Lit>&) (clause_level : int)  ->  [void]
+|
+|  Description:
+|    Publishes a freshly learnt clause (all of its literals still assigned) to the other portfolio
+|    threads if it is short and has a small literal block distance. Clauses that depend on user
+|    assertions above level 0 are kept local.
+|________________________________________________________________________________________________@*/
+void Solver::shareLearnt(const vec<Lit>& clause, int clause_level)
+{
+    if (clause_level > 0 || clause.size() > options::sharingFilterByLength())
+        return;
+
+    std::vector<int> levels;
+    for (int i = 0; i < clause.size(); i++)
+        levels.push_back(level(var(clause[i])));
+    std::sort(levels.begin(), levels.end());
+    unsigned lbd = std::unique(levels.begin(), levels.end()) - levels.begin();
+    if (lbd > options::sharingFilterByLbd())
+        return;
+
+    SatClause shared;
+    for (int i = 0; i < clause.size(); i++)
+        shared.push_back(MinisatSatSolver::toSatLiteral(clause[i]));
+    proxy->exportSharedClause(shared);
+}
+
+void Solver::importSharedClauses()
+{
+    assert(decisionLevel() == 0);
+    std::vector<SatClause> shared;
+    proxy->importSharedClauses(shared);
+    for (unsigned i = 0; i < shared.size() && ok; i++){
+        vec<Lit> ps;
+        MinisatSatSolver::toMinisatClause(shared[i], ps);
+        ClauseId id = ClauseIdUndef;
+        addClause(ps, true, id);
+    }
+}
+
 static double luby(double y, int x){
 
     // Find the finite subsequence that contains index 'x', and the
@@ -1472,6 +2038,8 @@ lbool Solver::solve_()
 
     solves++;
 
+    restoreActivity();
+
     max_learnts               = nClauses() * learntsize_factor;
     learntsize_adjust_confl   = learntsize_adjust_start_confl;
     learntsize_adjust_cnt     = (int)learntsize_adjust_confl;
@@ -1487,6 +2055,11 @@ lbool Solver::solve_()
     // Search:
     int curr_restarts = 0;
     while (status == l_Undef){
+        if (options::satLocalSearch()
+            && (curr_restarts == 0
+                || (options::satLocalSearchInterval() > 0
+                    && curr_restarts % options::satLocalSearchInterval() == 0)))
+          localSearchPhases();
         double rest_base = luby_restart ? luby(restart_inc, curr_restarts) : pow(restart_inc, curr_restarts);
         status = search(rest_base * restart_first);
         if (!withinBudget(options::satConflictStep())) break; // FIXME add restart option?
@@ -1624,6 +2197,12 @@ void Solver::relocAll(ClauseAllocator& to)
       ca.reloc(
           clauses_removable[i], to, NULLPROOF(ProofManager::getSatProof()));
 
+    // The cached XOR reasons (all of them are removable clauses)
+    //
+    for (int v = 0; v < nVars(); v++)
+      if (xor_reason_cache[v] != CRef_Undef)
+        ca.reloc(xor_reason_cache[v], to, NULLPROOF(ProofManager::getSatProof()));
+
     // All original:
     //
     for (int i = 0; i < clauses_persistent.size(); i++)
@@ -1662,6 +2241,56 @@ void Solver::push()
   Debug("minisat") << "MINISAT PUSH assertionLevel is " << assertionLevel << ", trail.size is " << trail.size() << std::endl;
 }
 
+/*_________________________________________________________________________________________________
+|
+|  saveActivity : (newSize : int) -> [void]
+|
+|  Description:
+|    Remember the activity of the theory atoms that are about to be removed by a user-level pop,
+|    keyed by their node. Only theory atoms have a node that outlives the variable. Must be
+|    called before the CNF stream forgets the literals of the popped level.
+|________________________________________________________________________________________________@*/
+void Solver::saveActivity(int newSize)
+{
+    if (!options::decisionKeepActivity()) return;
+    for (Var v = newSize; v < nVars(); v++) {
+        if (theory[v] && activity[v] > 0) {
+            CVC4::Node n = proxy->getNode(MinisatSatSolver::toSatLiteral(mkLit(v)));
+            saved_activity[n] = activity[v] / var_inc;
+        }
+    }
+    if (activity_restored_vars > newSize) activity_restored_vars = newSize;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  restoreActivity : () -> [void]
+|
+|  Description:
+|    Give the theory atoms introduced since the last call the activity they had when they were
+|    removed by a user-level pop, if any.
+|________________________________________________________________________________________________@*/
+void Solver::restoreActivity()
+{
+    if (saved_activity.empty()) {
+        activity_restored_vars = nVars();
+        return;
+    }
+    for (Var v = activity_restored_vars; v < nVars(); v++) {
+        if (!theory[v]) continue;
+        CVC4::Node n = proxy->getNode(MinisatSatSolver::toSatLiteral(mkLit(v)));
+        std::unordered_map<CVC4::Node, double, CVC4::NodeHashFunction>::iterator it = saved_activity.find(n);
+        if (it == saved_activity.end()) continue;
+        activity[v] = std::min(it->second * var_inc, 1e100);
+        if (order_heap.inHeap(v)) order_heap.decrease(v);
+        saved_activity.erase(it);
+        restored_activities++;
+    }
+    activity_restored_vars = nVars();
+}
+
+
 void Solver::pop()
 {
   assert(enable_incremental);
@@ -1695,10 +2324,37 @@ void Solver::pop()
   context->pop(); // SAT context for CVC4
 
   // Pop the created variables
+  saveActivity(assigns_lim.last());
   resizeVars(assigns_lim.last());
   assigns_lim.pop();
   variables_to_register.clear();
 
+  // Remove the XOR constraints above the level. The variables that are still
+  // assigned keep their XOR reasons, renumbered after the removal.
+  if (!xors.empty()) {
+    std::vector<int> renumber(xors.size(), -1);
+    size_t k = 0;
+    for (size_t i = 0; i < xors.size(); ++ i) {
+      if (xors[i].level <= assertionLevel) {
+        renumber[i] = k;
+        std::swap(xors[k++], xors[i]);
+      }
+    }
+    for (int v = 0; v < nVars(); ++ v) {
+      if (xor_reason[v] == -1) continue;
+      if (value(v) == l_Undef) {
+        xor_reason[v] = -1;
+      } else {
+        // A constraint above the level only propagates variables above it
+        Assert(renumber[xor_reason[v]] != -1);
+        xor_reason[v] = renumber[xor_reason[v]];
+      }
+    }
+    xors.erase(xors.begin() + k, xors.end());
+    rebuildXorWatches();
+    xors_dirty = true;
+  }
+
   // Pop the OK
   ok = trail_ok.last();
   trail_ok.pop();
@@ -1716,6 +2372,31 @@ CRef Solver::updateLemmas() {
   // Decision level to backtrack to
   int backtrackLevel = decisionLevel();
 
+  // See how far the XOR constraints need us to backtrack, as for the lemmas
+  // below: a constraint needs it if it propagates, or if it is in conflict
+  for (size_t i = 0; i < xors_pending.size(); ++ i) {
+    std::vector<Var>& vs = xors_pending[i].vars;
+    sortXorWatches(vs);
+    if (value(vs[1]) == l_Undef) continue;
+    int currentBacktrackLevel = level(vs[1]);
+    if (value(vs[0]) != l_Undef && level(vs[0]) == currentBacktrackLevel) {
+      // Both watches are assigned at the same level, keep them if satisfied
+      bool parity = xors_pending[i].rhs;
+      for (size_t k = 0; k < vs.size(); k++) {
+        parity ^= (value(vs[k]) == l_True);
+      }
+      if (!parity) continue;
+      currentBacktrackLevel = std::max(currentBacktrackLevel - 1, 0);
+    }
+    if (currentBacktrackLevel < backtrackLevel) {
+      backtrackLevel = currentBacktrackLevel;
+    }
+  }
+  if (backtrackLevel < decisionLevel()) {
+    Debug("minisat::lemmas") << "Solver::updateLemmas(): backtracking to " << backtrackLevel << " for XOR constraints" << std::endl;
+    cancelUntil(backtrackLevel);
+  }
+
   // We use this comparison operator
   lemma_lt lt(*this);
 
@@ -1839,6 +2520,21 @@ CRef Solver::updateLemmas() {
     }
   }
 
+  // Attach the XOR constraints
+  for (size_t i = 0; i < xors_pending.size(); ++ i)
+  {
+    xors.push_back(xors_pending[i]);
+    xor_constraints++;
+    CRef xorConflict = attachXor(xors.size() - 1);
+    if (conflict == CRef_Undef) {
+      conflict = xorConflict;
+    }
+  }
+  if (!xors_pending.empty()) {
+    xors_pending.clear();
+    xors_dirty = true;
+  }
+
   PROOF(Assert (lemmas.size() == (int)lemmas_cnf_assertion.size()););
   // Clear the lemmas
   lemmas.clear();
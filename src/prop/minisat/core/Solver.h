@@ -24,10 +24,15 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "cvc4_private.h"
 
 #include <iosfwd>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "base/output.h"
 #include "context/context.h"
 #include "proof/clause_id.h"
+#include "prop/decision_scheduler.h"
 #include "prop/minisat/core/SolverTypes.h"
 #include "prop/minisat/mtl/Alg.h"
 #include "prop/minisat/mtl/Heap.h"
@@ -183,6 +188,7 @@ public:
     bool    addClause (Lit p, Lit q, Lit r, bool removable, ClauseId& id); // Add a ternary clause to the solver.
     bool    addClause_(      vec<Lit>& ps, bool removable, ClauseId& id);  // Add a clause to the solver without making superflous internal copy. Will
                                                                                  // change the passed vector 'ps'.
+    bool    addXorClause(const vec<Var>& vs, bool rhs);                    // Add the constraint vs[0] xor ... xor vs[n-1] = rhs.
 
     // Solving:
     //
@@ -261,6 +267,7 @@ public:
     int       phase_saving;       // Controls the level of phase saving (0=none, 1=limited, 2=full).
     bool      rnd_pol;            // Use random polarities for branching heuristics.
     bool      rnd_init_act;       // Initialize variable activities with a small random value.
+    CVC4::prop::DecisionScheduler decision_scheduler; // Order in which the decision sources are asked.
     double    garbage_frac;       // The fraction of wasted memory allowed before a garbage collection is triggered.
 
     int       restart_first;      // The initial restart limit.                                                                (default 100)
@@ -275,6 +282,9 @@ public:
     //
     uint64_t solves, starts, decisions, rnd_decisions, propagations, conflicts, resources_consumed;
     uint64_t dec_vars, clauses_literals, learnts_literals, max_literals, tot_literals;
+    uint64_t xor_constraints, xor_propagations, xor_conflicts, xor_gauss_implied;
+    uint64_t sls_calls, sls_flips, sls_models;
+    uint64_t theory_decisions, engine_decisions, activity_decisions, restored_activities;
 
 protected:
 
@@ -354,6 +364,31 @@ protected:
     // CVC4 Stuff
     vec<bool>           theory;           // Is the variable representing a theory atom
 
+    // Native XOR constraints
+    struct XorConstraint {
+      // The variables of the constraint, vars[0] and vars[1] are watched
+      std::vector<Var> vars;
+      // The parity the variables must sum up to
+      bool rhs;
+      // User level of the constraint (removed on pops below it)
+      int level;
+      XorConstraint(const std::vector<Var>& vars, bool rhs, int level)
+      : vars(vars), rhs(rhs), level(level)
+      {}
+    };
+    std::vector<XorConstraint> xors;      // All the attached XOR constraints
+    std::vector<XorConstraint> xors_pending; // XOR constraints added while the solver is busy
+    vec< vec<int> >     xor_watches;      // 'xor_watches[v]' is a list of XOR constraints watching variable 'v'
+    vec<int>            xor_reason;       // The XOR constraint that propagated the variable (or -1)
+    vec<CRef>           xor_reason_cache; // The last reason clause materialized for the variable (or CRef_Undef)
+    std::unordered_set<uint64_t> xor_binaries; // Keys of the binary XOR constraints (see xorBinaryKey)
+    bool                xors_dirty;       // Were XOR constraints added since the last elimination
+
+    // Activity of the theory atoms removed by a user-level pop, relative to 'var_inc', so that a
+    // re-introduced atom starts from its old activity instead of from zero.
+    std::unordered_map<CVC4::Node, double, CVC4::NodeHashFunction> saved_activity;
+    int                 activity_restored_vars; // Variables below this index were checked against 'saved_activity'.
+
     enum TheoryCheckType {
       // Quick check, but don't perform theory reasoning
       CHECK_WITHOUT_THEORY,
@@ -387,12 +422,24 @@ protected:
     //
     void     insertVarOrder   (Var x);                                                 // Insert a variable in the decision order priority queue.
     Lit      pickBranchLit    ();                                                      // Return the next decision variable.
+    Lit      pickTheoryLit    ();                                                      // Return the next decision requested by the theories.
+    Lit      pickEngineLit    (bool& stopSearch);                                      // Return the next decision requested by the decision engine.
+    Lit      pickActivityLit  ();                                                      // Return the next decision by variable activity.
+    void     saveActivity     (int newSize);                                           // Remember the activity of the theory atoms above 'newSize'.
+    void     restoreActivity  ();                                                      // Restore the remembered activity of the re-introduced theory atoms.
     void     newDecisionLevel ();                                                      // Begins a new decision level.
     void     uncheckedEnqueue (Lit p, CRef from = CRef_Undef);                         // Enqueue a literal. Assumes value of literal is undefined.
     bool     enqueue          (Lit p, CRef from = CRef_Undef);                         // Test if fact 'p' contradicts current state, enqueue otherwise.
     bool     theoryConflict;                                                           // Was the last conflict a theory conflict
     CRef     propagate        (TheoryCheckType type);                                  // Perform Boolean and Theory. Returns possibly conflicting clause.
     CRef     propagateBool    ();                                                      // Perform Boolean propagation. Returns possibly conflicting clause.
+    CRef     propagateXor     (Var v);                                                 // Propagate the XOR constraints watching the assigned 'v'. Returns possibly conflicting clause.
+    CRef     attachXor        (int index);                                             // Watch the given XOR constraint, propagating it if needed. Returns possibly conflicting clause.
+    CRef     xorClause        (int index, Var implied);                                // Materialize the XOR constraint as a clause under the current assignment.
+    bool     xorReasonValid   (CRef cr, Var implied) const;                            // Does the cached reason clause still explain the current value of 'implied'?
+    void     sortXorWatches   (std::vector<Var>& vs) const;                            // Put the unassigned variables first, the rest by decreasing trail index.
+    bool     xorGaussEliminate();                                                      // Gauss-Jordan elimination of XOR constraints at level 0. Returns false on conflict.
+    void     rebuildXorWatches();                                                      // Rebuild 'xor_watches' from the XOR constraints.
     void     propagateTheory  ();                                                      // Perform Theory propagation.
     void     theoryCheck      (CVC4::theory::Theory::Effort effort);                   // Perform a theory satisfiability check. Adds lemmas.
     CRef     updateLemmas     ();                                                      // Add the lemmas, backtraking if necessary and return a conflict if there is one
@@ -401,6 +448,9 @@ protected:
     void     analyzeFinal     (Lit p, vec<Lit>& out_conflict);                         // COULD THIS BE IMPLEMENTED BY THE ORDINARIY "analyze" BY SOME REASONABLE GENERALIZATION?
     bool     litRedundant     (Lit p, uint32_t abstract_levels);                       // (helper method for 'analyze()') - true if p is redundant
     lbool    search           (int nof_conflicts);                                     // Search for a given number of conflicts.
+    void     localSearchPhases();                                                      // Seed the saved phases by local search over the clauses at level 0.
+    void     shareLearnt      (const vec<Lit>& clause, int clause_level);              // Publish a learnt clause to the other portfolio threads, if it passes the filters.
+    void     importSharedClauses();                                                    // Add the clauses published by the other portfolio threads as removable lemmas.
     lbool    solve_           ();                                                      // Main solve method (assumptions given in 'assumptions').
     void     reduceDB         ();                                                      // Reduce the set of learnt clauses.
     void     removeSatisfied  (vec<CRef>& cs);                                         // Shrink 'cs' to contain only non-satisfied clauses.
@@ -445,6 +495,11 @@ protected:
     // Static helpers:
     //
 
+    // Returns a key identifying the binary XOR constraint x xor y = rhs.
+    static inline uint64_t xorBinaryKey(Var x, Var y, bool rhs) {
+        if (x > y) std::swap(x, y);
+        return ((uint64_t)x << 33) | ((uint64_t)y << 1) | (uint64_t)rhs; }
+
     // Returns a random float 0 <= x < 1. Seed must never be 0.
     static inline double drand(double& seed) {
         seed *= 1389796;
@@ -18,6 +18,7 @@
 
 #include "options/base_options.h"
 #include "options/decision_options.h"
+#include "options/main_options.h"
 #include "options/prop_options.h"
 #include "options/smt_options.h"
 #include "prop/minisat/simp/SimpSolver.h"
@@ -111,10 +112,18 @@ void MinisatSatSolver::initialize(context::Context* context, TheoryProxy* theory
              << " unless using internal decision strategy." << std::endl;
   }
 
+  // Clauses shared by other portfolio threads may mention eliminated variables
+  bool sharing = options::sharingFilterByLength() > 0;
+  if (sharing) {
+    Notice() << "minisat: Incremental solving is forced on (to avoid variable elimination)"
+             << " when sharing learned clauses." << std::endl;
+  }
+
   // Create the solver
   d_minisat = new Minisat::SimpSolver(theoryProxy, d_context,
                                       options::incrementalSolving() ||
-                                      options::decisionMode() != decision::DECISION_STRATEGY_INTERNAL );
+                                      options::decisionMode() != decision::DECISION_STRATEGY_INTERNAL ||
+                                      sharing );
 
   d_statistics.init(d_minisat);
 }
@@ -139,6 +148,14 @@ void MinisatSatSolver::setupOptions() {
   d_minisat->clause_decay = options::satClauseDecay();
   d_minisat->restart_first = options::satRestartFirst();
   d_minisat->restart_inc = options::satRestartInc();
+
+  // Set up the order of the decision sources
+  d_minisat->decision_scheduler.setWeight(DecisionScheduler::THEORY,
+                                          options::decisionShareTheory());
+  d_minisat->decision_scheduler.setWeight(DecisionScheduler::ENGINE,
+                                          options::decisionShareEngine());
+  d_minisat->decision_scheduler.setWeight(DecisionScheduler::ACTIVITY,
+                                          options::decisionShareActivity());
 }
 
 ClauseId MinisatSatSolver::addClause(SatClause& clause, bool removable) {
@@ -155,6 +172,25 @@ ClauseId MinisatSatSolver::addClause(SatClause& clause, bool removable) {
   return clause_id;
 }
 
+ClauseId MinisatSatSolver::addXorClause(SatClause& clause,
+                                        bool rhs,
+                                        bool removable)
+{
+  // FIXME: as in addClause(), this relies on Minisat not adding anything
+  // when ok() is false
+  if (!ok()) {
+    return ClauseIdUndef;
+  }
+  // Push the negations of the literals into the right-hand side
+  Minisat::vec<Minisat::Var> minisat_xor;
+  for (unsigned i = 0; i < clause.size(); ++i) {
+    minisat_xor.push(clause[i].getSatVariable());
+    rhs ^= clause[i].isNegated();
+  }
+  d_minisat->addXorClause(minisat_xor, rhs);
+  return ClauseIdUndef;
+}
+
 SatVariable MinisatSatSolver::newVar(bool isTheoryAtom, bool preRegister, bool canErase) {
   return d_minisat->newVar(true, true, isTheoryAtom, preRegister, canErase);
 }
@@ -241,7 +277,18 @@ MinisatSatSolver::Statistics::Statistics(StatisticsRegistry* registry) :
     d_statClausesLiterals("sat::clauses_literals"),
     d_statLearntsLiterals("sat::learnts_literals"),
     d_statMaxLiterals("sat::max_literals"),
-    d_statTotLiterals("sat::tot_literals")
+    d_statTotLiterals("sat::tot_literals"),
+    d_statXorConstraints("sat::xor_constraints"),
+    d_statXorPropagations("sat::xor_propagations"),
+    d_statXorConflicts("sat::xor_conflicts"),
+    d_statXorGaussImplied("sat::xor_gauss_implied"),
+    d_statSlsCalls("sat::sls_calls"),
+    d_statSlsFlips("sat::sls_flips"),
+    d_statSlsModels("sat::sls_models"),
+    d_statTheoryDecisions("sat::theory_decisions"),
+    d_statEngineDecisions("sat::engine_decisions"),
+    d_statActivityDecisions("sat::activity_decisions"),
+    d_statRestoredActivities("sat::restored_activities")
 {
   d_registry->registerStat(&d_statStarts);
   d_registry->registerStat(&d_statDecisions);
@@ -252,6 +299,17 @@ MinisatSatSolver::Statistics::Statistics(StatisticsRegistry* registry) :
   d_registry->registerStat(&d_statLearntsLiterals);
   d_registry->registerStat(&d_statMaxLiterals);
   d_registry->registerStat(&d_statTotLiterals);
+  d_registry->registerStat(&d_statXorConstraints);
+  d_registry->registerStat(&d_statXorPropagations);
+  d_registry->registerStat(&d_statXorConflicts);
+  d_registry->registerStat(&d_statXorGaussImplied);
+  d_registry->registerStat(&d_statSlsCalls);
+  d_registry->registerStat(&d_statSlsFlips);
+  d_registry->registerStat(&d_statSlsModels);
+  d_registry->registerStat(&d_statTheoryDecisions);
+  d_registry->registerStat(&d_statEngineDecisions);
+  d_registry->registerStat(&d_statActivityDecisions);
+  d_registry->registerStat(&d_statRestoredActivities);
 }
 
 MinisatSatSolver::Statistics::~Statistics() {
@@ -264,6 +322,17 @@ MinisatSatSolver::Statistics::~Statistics() {
   d_registry->unregisterStat(&d_statLearntsLiterals);
   d_registry->unregisterStat(&d_statMaxLiterals);
   d_registry->unregisterStat(&d_statTotLiterals);
+  d_registry->unregisterStat(&d_statXorConstraints);
+  d_registry->unregisterStat(&d_statXorPropagations);
+  d_registry->unregisterStat(&d_statXorConflicts);
+  d_registry->unregisterStat(&d_statXorGaussImplied);
+  d_registry->unregisterStat(&d_statSlsCalls);
+  d_registry->unregisterStat(&d_statSlsFlips);
+  d_registry->unregisterStat(&d_statSlsModels);
+  d_registry->unregisterStat(&d_statTheoryDecisions);
+  d_registry->unregisterStat(&d_statEngineDecisions);
+  d_registry->unregisterStat(&d_statActivityDecisions);
+  d_registry->unregisterStat(&d_statRestoredActivities);
 }
 
 void MinisatSatSolver::Statistics::init(Minisat::SimpSolver* d_minisat){
@@ -276,6 +345,17 @@ void MinisatSatSolver::Statistics::init(Minisat::SimpSolver* d_minisat){
   d_statLearntsLiterals.setData(d_minisat->learnts_literals);
   d_statMaxLiterals.setData(d_minisat->max_literals);
   d_statTotLiterals.setData(d_minisat->tot_literals);
+  d_statXorConstraints.setData(d_minisat->xor_constraints);
+  d_statXorPropagations.setData(d_minisat->xor_propagations);
+  d_statXorConflicts.setData(d_minisat->xor_conflicts);
+  d_statXorGaussImplied.setData(d_minisat->xor_gauss_implied);
+  d_statSlsCalls.setData(d_minisat->sls_calls);
+  d_statSlsFlips.setData(d_minisat->sls_flips);
+  d_statSlsModels.setData(d_minisat->sls_models);
+  d_statTheoryDecisions.setData(d_minisat->theory_decisions);
+  d_statEngineDecisions.setData(d_minisat->engine_decisions);
+  d_statActivityDecisions.setData(d_minisat->activity_decisions);
+  d_statRestoredActivities.setData(d_minisat->restored_activities);
 }
 
 } /* namespace CVC4::prop */
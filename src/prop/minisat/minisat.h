@@ -42,10 +42,9 @@ public:
   void initialize(context::Context* context, TheoryProxy* theoryProxy) override;
 
   ClauseId addClause(SatClause& clause, bool removable) override;
-  ClauseId addXorClause(SatClause& clause, bool rhs, bool removable) override
-  {
-    Unreachable("Minisat does not support native XOR reasoning");
-  }
+
+  bool nativeXor() override { return true; }
+  ClauseId addXorClause(SatClause& clause, bool rhs, bool removable) override;
 
   SatVariable newVar(bool isTheoryAtom,
                      bool preRegister,
@@ -98,6 +97,11 @@ public:
     ReferenceStat<uint64_t> d_statConflicts, d_statClausesLiterals;
     ReferenceStat<uint64_t> d_statLearntsLiterals,  d_statMaxLiterals;
     ReferenceStat<uint64_t> d_statTotLiterals;
+    ReferenceStat<uint64_t> d_statXorConstraints, d_statXorPropagations;
+    ReferenceStat<uint64_t> d_statXorConflicts, d_statXorGaussImplied;
+    ReferenceStat<uint64_t> d_statSlsCalls, d_statSlsFlips, d_statSlsModels;
+    ReferenceStat<uint64_t> d_statTheoryDecisions, d_statEngineDecisions;
+    ReferenceStat<uint64_t> d_statActivityDecisions, d_statRestoredActivities;
   public:
     Statistics(StatisticsRegistry* registry);
     ~Statistics();
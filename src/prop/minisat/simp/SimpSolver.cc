@@ -162,6 +162,20 @@ lbool SimpSolver::solve_(bool do_simp, bool turn_off_simp)
 
 
 
+bool SimpSolver::addXorClause(const vec<Var>& vs, bool rhs)
+{
+    // The variables of XOR constraints must not be eliminated
+    if (use_simplification) {
+      for (int i = 0; i < vs.size(); i++){
+        assert(!isEliminated(vs[i]));
+        setFrozen(vs[i], true);
+      }
+    }
+
+    return Solver::addXorClause(vs, rhs);
+}
+
+
 bool SimpSolver::addClause_(vec<Lit>& ps, bool removable, ClauseId& id)
 {
 #ifndef NDEBUG
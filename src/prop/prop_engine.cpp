@@ -260,6 +260,11 @@ void PropEngine::getBooleanVariables(std::vector<TNode>& outputVariables) const
   d_cnfStream->getBooleanVariables(outputVariables);
 }
 
+void PropEngine::getSplitAtoms(unsigned k, std::vector<Node>& atoms) const {
+  Assert(!d_inCheckSat, "Sat solver in solve()!");
+  d_decisionEngine->getSplitAtoms(k, atoms);
+}
+
 void PropEngine::ensureLiteral(TNode n) {
   d_cnfStream->ensureLiteral(n);
 }
@@ -183,6 +183,12 @@ public:
    */
   void getBooleanVariables(std::vector<TNode>& outputVariables) const;
 
+  /**
+   * Get at most k unassigned atoms to split the search space on, as
+   * suggested by the decision engine, best first.
+   */
+  void getSplitAtoms(unsigned k, std::vector<Node>& atoms) const;
+
   /**
    * Ensure that the given node will have a designated SAT literal
    * that is definitionally equal to it.  The result of this function
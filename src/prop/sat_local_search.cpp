@@ -0,0 +1,176 @@
+/*********************                                                        */
+/*! \file sat_local_search.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Stochastic local search over the Boolean skeleton.
+ **
+ ** Implementation of the ProbSAT-style local search engine.
+ **/
+
+#include "prop/sat_local_search.h"
+
+#include <cmath>
+
+#include "base/cvc4_assert.h"
+#include "util/random.h"
+
+namespace CVC4 {
+namespace prop {
+
+namespace {
+
+/** Parameters of the polynomial ProbSAT distribution (Balint, Schoening). */
+const double s_probsatEps = 0.9;
+const double s_probsatCb = 2.3;
+/** Break values for which the probability is cached. */
+const unsigned s_probsatCached = 64;
+
+}  // namespace
+
+SatLocalSearch::SatLocalSearch(unsigned numVars)
+    : d_start(1, 0),
+      d_occurs(2 * numVars),
+      d_assign(numVars, false),
+      d_best(numVars, false),
+      d_bestUnsat(0),
+      d_flips(0)
+{
+  d_probs.reserve(s_probsatCached);
+  for (unsigned b = 0; b < s_probsatCached; ++b)
+  {
+    d_probs.push_back(std::pow(s_probsatEps + b, -s_probsatCb));
+  }
+}
+
+void SatLocalSearch::addClause(const std::vector<unsigned>& lits)
+{
+  Assert(!lits.empty());
+  unsigned clause = d_start.size() - 1;
+  for (unsigned lit : lits)
+  {
+    Assert((lit >> 1) < d_assign.size());
+    d_lits.push_back(lit);
+    d_occurs[lit].push_back(clause);
+  }
+  d_start.push_back(d_lits.size());
+}
+
+unsigned SatLocalSearch::breakValue(unsigned var) const
+{
+  // The literal of var that is currently true
+  unsigned lit = 2 * var + (d_assign[var] ? 0 : 1);
+  unsigned result = 0;
+  for (unsigned clause : d_occurs[lit])
+  {
+    if (d_numTrue[clause] == 1)
+    {
+      ++result;
+    }
+  }
+  return result;
+}
+
+void SatLocalSearch::makeUnsat(unsigned clause)
+{
+  d_unsatPos[clause] = d_unsat.size();
+  d_unsat.push_back(clause);
+}
+
+void SatLocalSearch::makeSat(unsigned clause)
+{
+  unsigned last = d_unsat.back();
+  d_unsat[d_unsatPos[clause]] = last;
+  d_unsatPos[last] = d_unsatPos[clause];
+  d_unsat.pop_back();
+}
+
+void SatLocalSearch::flip(unsigned var)
+{
+  unsigned falsified = 2 * var + (d_assign[var] ? 0 : 1);
+  d_assign[var] = !d_assign[var];
+  for (unsigned clause : d_occurs[falsified ^ 1])
+  {
+    if (d_numTrue[clause]++ == 0)
+    {
+      makeSat(clause);
+    }
+  }
+  for (unsigned clause : d_occurs[falsified])
+  {
+    if (--d_numTrue[clause] == 0)
+    {
+      makeUnsat(clause);
+    }
+  }
+}
+
+bool SatLocalSearch::run(uint64_t maxFlips)
+{
+  unsigned numClauses = d_start.size() - 1;
+  d_numTrue.assign(numClauses, 0);
+  d_unsatPos.assign(numClauses, 0);
+  d_unsat.clear();
+  for (unsigned clause = 0; clause < numClauses; ++clause)
+  {
+    for (unsigned i = d_start[clause]; i < d_start[clause + 1]; ++i)
+    {
+      if (isTrue(d_lits[i]))
+      {
+        ++d_numTrue[clause];
+      }
+    }
+    if (d_numTrue[clause] == 0)
+    {
+      makeUnsat(clause);
+    }
+  }
+
+  d_best = d_assign;
+  d_bestUnsat = d_unsat.size();
+  d_flips = 0;
+
+  Random& rnd = Random::getRandom();
+  while (!d_unsat.empty() && d_flips < maxFlips)
+  {
+    unsigned clause = d_unsat[rnd.pick(0, d_unsat.size() - 1)];
+    unsigned begin = d_start[clause], end = d_start[clause + 1];
+
+    // Pick a variable of the clause with probability (eps + break)^-cb
+    d_scores.clear();
+    double sum = 0;
+    for (unsigned i = begin; i < end; ++i)
+    {
+      unsigned b = breakValue(d_lits[i] >> 1);
+      double p = b < s_probsatCached ? d_probs[b]
+                                     : std::pow(s_probsatEps + b, -s_probsatCb);
+      sum += p;
+      d_scores.push_back(sum);
+    }
+    // Uniform in [0, sum), from the top 53 bits of a random number
+    double threshold = sum * (rnd.rand() >> 11) / double(uint64_t(1) << 53);
+    unsigned i = 0;
+    while (i + 1 < d_scores.size() && d_scores[i] < threshold)
+    {
+      ++i;
+    }
+
+    flip(d_lits[begin + i] >> 1);
+    ++d_flips;
+
+    if (d_unsat.size() < d_bestUnsat)
+    {
+      d_best = d_assign;
+      d_bestUnsat = d_unsat.size();
+    }
+  }
+
+  return d_bestUnsat == 0;
+}
+
+}  // namespace prop
+}  // namespace CVC4
@@ -0,0 +1,102 @@
+/*********************                                                        */
+/*! \file sat_local_search.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Stochastic local search over the Boolean skeleton.
+ **
+ ** A small ProbSAT-style local search engine. The SAT solver hands it the
+ ** clauses that are not yet satisfied at the top level, runs it for a bounded
+ ** number of flips and uses the best assignment found to seed its saved
+ ** phases.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PROP__SAT_LOCAL_SEARCH_H
+#define CVC4__PROP__SAT_LOCAL_SEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace CVC4 {
+namespace prop {
+
+/**
+ * ProbSAT local search with the polynomial break-value distribution.
+ *
+ * Variables are numbered 0 .. n-1 and a literal is encoded as 2 * var + sign,
+ * where sign is 1 for the negative literal (the MiniSat encoding). Clauses are
+ * added once, after which run() can be called with an initial assignment set
+ * through setValue().
+ */
+class SatLocalSearch
+{
+ public:
+  SatLocalSearch(unsigned numVars);
+
+  /** Add a clause. The clause must not be empty. */
+  void addClause(const std::vector<unsigned>& lits);
+
+  /** Set the value of var in the initial assignment. */
+  void setValue(unsigned var, bool value) { d_assign[var] = value; }
+
+  /**
+   * Run local search for at most maxFlips flips, starting from the current
+   * assignment. Returns true if a satisfying assignment was found.
+   */
+  bool run(uint64_t maxFlips);
+
+  /** The value of var in the best assignment found by run(). */
+  bool bestValue(unsigned var) const { return d_best[var]; }
+
+  /** Number of clauses falsified by the best assignment. */
+  size_t bestUnsat() const { return d_bestUnsat; }
+
+  /** Number of flips performed by the last call to run(). */
+  uint64_t flips() const { return d_flips; }
+
+ private:
+  /** Is lit true under the current assignment? */
+  bool isTrue(unsigned lit) const { return d_assign[lit >> 1] != (lit & 1); }
+
+  /** Number of clauses that become falsified if var is flipped. */
+  unsigned breakValue(unsigned var) const;
+
+  /** Flip var and update the clause counters and the unsat set. */
+  void flip(unsigned var);
+
+  void makeUnsat(unsigned clause);
+  void makeSat(unsigned clause);
+
+  /** Clause literals, clause i spans d_lits[d_start[i] .. d_start[i+1]). */
+  std::vector<unsigned> d_lits;
+  std::vector<unsigned> d_start;
+  /** Clauses each literal occurs in. */
+  std::vector<std::vector<unsigned>> d_occurs;
+  /** Number of true literals of each clause. */
+  std::vector<unsigned> d_numTrue;
+  /** Falsified clauses and the position of each clause in that list. */
+  std::vector<unsigned> d_unsat;
+  std::vector<unsigned> d_unsatPos;
+
+  std::vector<bool> d_assign;
+  std::vector<bool> d_best;
+  size_t d_bestUnsat;
+  uint64_t d_flips;
+
+  /** Cached (eps + b)^-cb for small break values b. */
+  std::vector<double> d_probs;
+  /** Scratch space for the probabilities of the current clause. */
+  std::vector<double> d_scores;
+}; /* class SatLocalSearch */
+
+}  // namespace prop
+}  // namespace CVC4
+
+#endif /* CVC4__PROP__SAT_LOCAL_SEARCH_H */
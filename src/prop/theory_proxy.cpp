@@ -20,9 +20,11 @@
 #include "decision/decision_engine.h"
 #include "expr/expr_stream.h"
 #include "options/decision_options.h"
+#include "options/main_options.h"
 #include "prop/cnf_stream.h"
 #include "prop/prop_engine.h"
 #include "proof/cnf_proof.h"
+#include "proof/proof_manager.h"
 #include "smt/command.h"
 #include "smt/smt_statistics_registry.h"
 #include "smt_util/lemma_input_channel.h"
@@ -51,14 +53,23 @@ TheoryProxy::TheoryProxy(PropEngine* propEngine,
       d_replayLog(replayLog),
       d_replayStream(replayStream),
       d_queue(context),
-      d_replayedDecisions("prop::theoryproxy::replayedDecisions", 0)
+      d_replayedDecisions("prop::theoryproxy::replayedDecisions", 0),
+      d_sharedClausesExported("prop::theoryproxy::sharedClausesExported", 0),
+      d_sharedClausesImported("prop::theoryproxy::sharedClausesImported", 0),
+      d_sharedClausesDropped("prop::theoryproxy::sharedClausesDropped", 0)
 {
   smtStatisticsRegistry()->registerStat(&d_replayedDecisions);
+  smtStatisticsRegistry()->registerStat(&d_sharedClausesExported);
+  smtStatisticsRegistry()->registerStat(&d_sharedClausesImported);
+  smtStatisticsRegistry()->registerStat(&d_sharedClausesDropped);
 }
 
 TheoryProxy::~TheoryProxy() {
   /* nothing to do for now */
   smtStatisticsRegistry()->unregisterStat(&d_replayedDecisions);
+  smtStatisticsRegistry()->unregisterStat(&d_sharedClausesExported);
+  smtStatisticsRegistry()->unregisterStat(&d_sharedClausesImported);
+  smtStatisticsRegistry()->unregisterStat(&d_sharedClausesDropped);
 }
 
 /** The lemma input channel we are using. */
@@ -71,6 +82,11 @@ LemmaOutputChannel* TheoryProxy::outputChannel() {
   return d_channels->getLemmaOutputChannel();
 }
 
+/** The clause sharing channel we are using. */
+ClauseSharingChannel* TheoryProxy::clauseSharingChannel() {
+  return d_channels->getClauseSharingChannel();
+}
+
 
 void TheoryProxy::variableNotify(SatVariable var) {
   d_theoryEngine->preRegister(getNode(SatLiteral(var)));
@@ -215,6 +231,98 @@ void TheoryProxy::notifyNewLemma(SatClause& lemma) {
   }
 }
 
+bool TheoryProxy::shareClauses() {
+  // A non-positive length filter turns sharing off in both directions; the
+  // SAT solver also only keeps its variables from being eliminated when it is
+  // positive
+  return clauseSharingChannel() != NULL && !PROOF_ON()
+         && options::sharingFilterByLength() > 0;
+}
+
+namespace {
+/**
+ * Only atoms are shared, the variables standing for Boolean connectives are
+ * local to the CNF conversion of each solver.
+ */
+bool isShareableAtom(TNode n)
+{
+  switch (n.getKind())
+  {
+    case kind::NOT:
+    case kind::AND:
+    case kind::OR:
+    case kind::XOR:
+    case kind::IMPLIES: return false;
+    case kind::ITE: return !n.getType().isBoolean();
+    case kind::EQUAL: return !n[0].getType().isBoolean();
+    default: return true;
+  }
+}
+}  // namespace
+
+void TheoryProxy::exportSharedClause(const SatClause& clause) {
+  Assert(shareClauses());
+  std::vector<uint32_t> lits;
+  for (unsigned i = 0, i_end = clause.size(); i < i_end; ++i) {
+    Node atom = d_cnfStream->getNode(SatLiteral(clause[i].getSatVariable()));
+    std::unordered_map<Node, uint32_t, NodeHashFunction>::const_iterator it =
+        d_sharedAtomIds.find(atom);
+    uint32_t id;
+    if (it != d_sharedAtomIds.end()) {
+      id = it->second;
+    } else {
+      if (!isShareableAtom(atom)
+          || !clauseSharingChannel()->getAtomId(atom.toExpr(), id)) {
+        id = d_notShared;
+      }
+      d_sharedAtomIds[atom] = id;
+      if (id != d_notShared) {
+        d_sharedAtoms[id] = atom;
+      }
+    }
+    if (id == d_notShared) {
+      ++d_sharedClausesDropped;
+      return;
+    }
+    lits.push_back(2 * id + (clause[i].isNegated() ? 1 : 0));
+  }
+  Debug("shared") << "exporting shared clause " << clause << std::endl;
+  clauseSharingChannel()->exportClause(lits);
+  ++d_sharedClausesExported;
+}
+
+void TheoryProxy::importSharedClauses(std::vector<SatClause>& clauses) {
+  Assert(shareClauses());
+  std::vector<uint32_t> lits;
+  while (clauseSharingChannel()->importClause(lits)) {
+    SatClause clause;
+    for (uint32_t lit : lits) {
+      uint32_t id = lit >> 1;
+      std::unordered_map<uint32_t, Node>::const_iterator it =
+          d_sharedAtoms.find(id);
+      if (it == d_sharedAtoms.end()) {
+        Node atom = Node::fromExpr(clauseSharingChannel()->getAtom(id));
+        it = d_sharedAtoms.insert(std::make_pair(id, atom)).first;
+        d_sharedAtomIds[atom] = id;
+      }
+      // Atoms that this solver does not know are not introduced
+      if (it->second.isNull() || !d_cnfStream->hasLiteral(it->second)) {
+        clause.clear();
+        break;
+      }
+      SatLiteral l = d_cnfStream->getLiteral(it->second);
+      clause.push_back((lit & 1) ? ~l : l);
+    }
+    if (clause.empty()) {
+      ++d_sharedClausesDropped;
+    } else {
+      Debug("shared") << "importing shared clause " << clause << std::endl;
+      clauses.push_back(clause);
+      ++d_sharedClausesImported;
+    }
+  }
+}
+
 SatLiteral TheoryProxy::getNextReplayDecision() {
 #ifdef CVC4_REPLAY
   if(d_replayStream != NULL) {
@@ -24,7 +24,9 @@
 #define CVC4_USE_MINISAT
 
 #include <iosfwd>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "context/cdqueue.h"
 #include "expr/expr_stream.h"
@@ -88,6 +90,21 @@ public:
 
   void notifyNewLemma(SatClause& lemma);
 
+  /** Is sharing of learned clauses at the literal level enabled? */
+  bool shareClauses();
+
+  /**
+   * Publish a learned clause through the clause sharing channel. The clause
+   * is dropped if one of its atoms can not be shared.
+   */
+  void exportSharedClause(const SatClause& clause);
+
+  /**
+   * Get the clauses published by the other solvers since the last call. Only
+   * the clauses over atoms that this solver knows are returned.
+   */
+  void importSharedClauses(std::vector<SatClause>& clauses);
+
   SatLiteral getNextReplayDecision();
 
   void logDecision(SatLiteral lit);
@@ -132,6 +149,9 @@ public:
   /** The lemma output channel we are using. */
   LemmaOutputChannel* outputChannel();
 
+  /** The clause sharing channel we are using. */
+  ClauseSharingChannel* clauseSharingChannel();
+
   /** Queue of asserted facts */
   context::CDQueue<TNode> d_queue;
 
@@ -141,6 +161,22 @@ public:
    */
   std::unordered_set<Node, NodeHashFunction> d_shared;
 
+  /**
+   * Shared identifiers of the atoms of this solver that have been exported
+   * (d_notShared if the atom can not be shared).
+   */
+  std::unordered_map<Node, uint32_t, NodeHashFunction> d_sharedAtomIds;
+
+  /** Atoms of the shared identifiers that have been imported. */
+  std::unordered_map<uint32_t, Node> d_sharedAtoms;
+
+  static const uint32_t d_notShared = uint32_t(-1);
+
+  /** Statistics on clause sharing. */
+  IntStat d_sharedClausesExported;
+  IntStat d_sharedClausesImported;
+  IntStat d_sharedClausesDropped;
+
   /**
    * Statistic: the number of replayed decisions (via --replay).
    */
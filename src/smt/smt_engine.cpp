@@ -1462,6 +1462,11 @@ void SmtEngine::setDefaults() {
       throw OptionException(
           "bitblast-aig not supported with unsat cores/proofs");
     }
+
+    if (options::satXor())
+    {
+      throw OptionException("sat-xor not supported with unsat cores/proofs");
+    }
   }
   else
   {
@@ -3822,6 +3827,42 @@ vector<Expr> SmtEngine::getUnsatAssumptions(void)
   return res;
 }
 
+vector<Expr> SmtEngine::getSplitAtoms(unsigned k)
+{
+  Trace("smt") << "SMT getSplitAtoms(" << k << ")" << endl;
+  SmtScope smts(this);
+  finalOptionsAreSet();
+  doPendingPops();
+
+  // Make sure the prop layer has all of the assertions
+  d_private->processAssertions();
+
+  // Ask for more, as some of the atoms may be left out
+  vector<Node> atoms;
+  d_propEngine->getSplitAtoms(4 * k, atoms);
+  vector<Expr> res;
+  for (const Node& atom : atoms)
+  {
+    if (res.size() == k)
+    {
+      break;
+    }
+    unordered_set<Node, NodeHashFunction> syms;
+    expr::getSymbols(atom, syms);
+    bool internal = false;
+    for (const Node& sym : syms)
+    {
+      internal = internal || sym.getKind() == kind::SKOLEM;
+    }
+    if (!internal)
+    {
+      res.push_back(atom.toExpr());
+    }
+  }
+  Trace("smt") << "SMT getSplitAtoms(" << k << ") => " << res << endl;
+  return res;
+}
+
 Result SmtEngine::assertFormula(const Expr& ex, bool inUnsatCore)
 {
   Assert(ex.getExprManager() == d_exprManager);
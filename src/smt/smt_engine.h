@@ -628,6 +628,15 @@ class CVC4_PUBLIC SmtEngine {
    */
   std::vector<Expr> getUnsatAssumptions(void);
 
+  /**
+   * Get at most k atoms to split the search space on, best first, e.g. to
+   * solve the current assertions by cube-and-conquer. The atoms are chosen
+   * by the decision engine from the preprocessed assertions; atoms over
+   * symbols introduced by the preprocessing are left out. Returns fewer atoms
+   * (possibly none) if the decision engine knows none that are unassigned.
+   */
+  std::vector<Expr> getSplitAtoms(unsigned k);
+
   /*------------------- sygus commands  ------------------*/
 
   /** adds a variable declaration
@@ -0,0 +1,67 @@
+/*********************                                                        */
+/*! \file clause_sharing_channel.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Mechanism for sharing learned clauses between SAT solvers
+ **
+ ** This file defines an interface for use by the propositional engine to
+ ** exchange learned clauses with the "outside world," for example with the
+ ** SAT solvers of the other portfolio threads. Clauses are exchanged at the
+ ** literal level, over a numbering of atoms that is common to all the
+ ** participants.
+ **/
+
+#include "cvc4_public.h"
+
+#ifndef CVC4__CLAUSE_SHARING_CHANNEL_H
+#define CVC4__CLAUSE_SHARING_CHANNEL_H
+
+#include <cstdint>
+#include <vector>
+
+#include "expr/expr.h"
+
+namespace CVC4 {
+
+/**
+ * This interface describes a mechanism for the propositional engine to
+ * exchange short learned clauses with other solvers. A shared literal is
+ * 2 * id + (1 if negated), where id is the shared identifier of its atom (see
+ * getAtomId()).
+ */
+class CVC4_PUBLIC ClauseSharingChannel {
+ public:
+  virtual ~ClauseSharingChannel() {}
+
+  /**
+   * Get the shared identifier of the given atom. Returns false if the atom
+   * can not be shared, e.g. because it contains symbols that are local to
+   * this solver. This is called once per atom, so it may be expensive.
+   */
+  virtual bool getAtomId(Expr atom, uint32_t& id) = 0;
+
+  /**
+   * Get the atom with the given shared identifier, in the expression manager
+   * of this solver. This is called once per identifier, so it may be
+   * expensive.
+   */
+  virtual Expr getAtom(uint32_t id) = 0;
+
+  /** Publish a clause over shared literals. This must not block. */
+  virtual void exportClause(const std::vector<uint32_t>& lits) = 0;
+
+  /**
+   * Get the next clause published by somebody else into lits. Returns false
+   * if there are no new clauses. This must not block.
+   */
+  virtual bool importClause(std::vector<uint32_t>& lits) = 0;
+}; /* class ClauseSharingChannel */
+
+} /* CVC4 namespace */
+
+#endif /* CVC4__CLAUSE_SHARING_CHANNEL_H */
@@ -38,6 +38,7 @@ namespace CVC4 {
 LemmaChannels::LemmaChannels()
     : d_lemmaInputChannel(NULL)
     , d_lemmaOutputChannel(NULL)
+    , d_clauseSharingChannel(NULL)
 {}
 
 LemmaChannels::~LemmaChannels(){}
@@ -50,5 +51,9 @@ void LemmaChannels::setLemmaOutputChannel(LemmaOutputChannel* out) {
   d_lemmaOutputChannel = out;
 }
 
+void LemmaChannels::setClauseSharingChannel(ClauseSharingChannel* channel) {
+  d_clauseSharingChannel = channel;
+}
+
 
 } /* namespace CVC4 */
@@ -33,22 +33,24 @@
 #include <utility>
 
 #include "options/option_exception.h"
+#include "smt_util/clause_sharing_channel.h"
 #include "smt_util/lemma_input_channel.h"
 #include "smt_util/lemma_output_channel.h"
 
 namespace CVC4 {
 
 /**
- * LemmaChannels is a wrapper around two pointers:
+ * LemmaChannels is a wrapper around three pointers:
  * - getLemmaInputChannel()
  * - getLemmaOutputChannel()
+ * - getClauseSharingChannel()
  *
  * The user can directly set these and is responsible for handling the
  * memory for these. These datastructures are used for Portfolio mode.
  */
 class CVC4_PUBLIC LemmaChannels {
  public:
-  /** Creates an empty LemmaChannels with all 4 pointers initially NULL. */
+  /** Creates an empty LemmaChannels with all pointers initially NULL. */
   LemmaChannels();
   ~LemmaChannels();
 
@@ -58,6 +60,12 @@ class CVC4_PUBLIC LemmaChannels {
   void setLemmaOutputChannel(LemmaOutputChannel* out);
   LemmaOutputChannel* getLemmaOutputChannel() { return d_lemmaOutputChannel; }
 
+  void setClauseSharingChannel(ClauseSharingChannel* channel);
+  ClauseSharingChannel* getClauseSharingChannel()
+  {
+    return d_clauseSharingChannel;
+  }
+
  private:
   // Disable copy constructor.
   LemmaChannels(const LemmaChannels&) = delete;
@@ -70,6 +78,9 @@ class CVC4_PUBLIC LemmaChannels {
 
   /** This captures the old options::lemmaOutputChannel .*/
   LemmaOutputChannel* d_lemmaOutputChannel;
+
+  /** Channel for sharing learned clauses at the SAT level. */
+  ClauseSharingChannel* d_clauseSharingChannel;
 }; /* class LemmaChannels */
 
 } /* namespace CVC4 */
@@ -17,12 +17,15 @@
 #include "theory/arith/approx_simplex.h"
 
 #include <math.h>
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
+#include <limits>
 #include <unordered_set>
 
 #include "base/output.h"
 #include "cvc4autoconfig.h"
+#include "options/arith_options.h"
 #include "smt/smt_statistics_registry.h"
 #include "theory/arith/constraint.h"
 #include "theory/arith/cut_log.h"
@@ -325,6 +328,56 @@ Maybe<Rational> ApproximateSimplex::estimateWithCFE(double d)
   return estimateWithCFE(d, s_defaultMaxDenom);
 }
 
+DeltaRational ApproximateSimplex::estimateAssignment(ArithVar v,
+                                                     double newAssign) const
+{
+  if (d_vars.hasLowerBound(v)
+      && roughlyEqual(newAssign,
+                      d_vars.getLowerBound(v).approx(SMALL_FIXED_DELTA)))
+  {
+    return d_vars.getLowerBound(v);
+  }
+  if (d_vars.hasUpperBound(v)
+      && roughlyEqual(newAssign,
+                      d_vars.getUpperBound(v).approx(SMALL_FIXED_DELTA)))
+  {
+    return d_vars.getUpperBound(v);
+  }
+
+  const DeltaRational& oldAssign = d_vars.getAssignment(v);
+  double rounded = round(newAssign);
+  if (roughlyEqual(newAssign, rounded))
+  {
+    newAssign = rounded;
+  }
+
+  DeltaRational proposal;
+  if (Maybe<Rational> maybe_new = estimateWithCFE(newAssign))
+  {
+    proposal = maybe_new.value();
+  }
+  else
+  {
+    // failed to estimate the old value. defaulting to the current.
+    proposal = oldAssign;
+  }
+
+  if (roughlyEqual(newAssign, oldAssign.approx(SMALL_FIXED_DELTA)))
+  {
+    proposal = oldAssign;
+  }
+
+  if (d_vars.strictlyLessThanLowerBound(v, proposal))
+  {
+    proposal = d_vars.getLowerBound(v);
+  }
+  else if (d_vars.strictlyGreaterThanUpperBound(v, proposal))
+  {
+    proposal = d_vars.getUpperBound(v);
+  }
+  return proposal;
+}
+
 class ApproxNoOp : public ApproximateSimplex {
 public:
   ApproxNoOp(const ArithVariables& v, TreeLog& l, ApproximateStatistics& s)
@@ -360,6 +413,535 @@ public:
   double sumInfeasibilities(bool mip) const override { return 0.0; }
 };
 
+/**
+ * A dense floating point simplex that only solves the linear relaxation. It
+ * starts from the basis of the auxiliary variables and minimizes the sum of
+ * infeasibilities of the basic variables with a bounded primal simplex:
+ * Dantzig pricing that falls back to Bland's rule after a run of degenerate
+ * pivots, and a ratio test that stops at the first breakpoint, so the sum
+ * never increases. A variable that reaches its other bound before any basic
+ * variable blocks is flipped without a pivot.
+ *
+ * The basis it finds is only a guess: the exact simplex verifies and repairs
+ * it (see AttemptSolutionSDP).
+ */
+class ApproxFloat : public ApproximateSimplex {
+public:
+  ApproxFloat(const ArithVariables& v,
+              TreeLog& l,
+              ApproximateStatistics& s,
+              const DenseMap<double>& margins);
+  ~ApproxFloat(){}
+
+  LinResult solveRelaxation() override;
+  Solution extractRelaxation() const override;
+
+  ArithRatPairVec heuristicOptCoeffs() const override
+  {
+    return ArithRatPairVec();
+  }
+
+  MipResult solveMIP(bool al) override { return MipUnknown; }
+  Solution extractMIP() const override { return Solution(); }
+
+  void setOptCoeffs(const ArithRatPairVec& ref) override {}
+
+  void tryCut(int nid, CutInfo& cut) override {}
+
+  std::vector<const CutInfo*> getValidCuts(const NodeLog& node) override
+  {
+    return std::vector<const CutInfo*>();
+  }
+
+  ArithVar getBranchVar(const NodeLog& nl) const override
+  {
+    return ARITHVAR_SENTINEL;
+  }
+
+  double sumInfeasibilities(bool mip) const override;
+
+private:
+  /** Fills in the tableau, the bounds and the starting values. */
+  bool buildTableau();
+
+  /** Recomputes the values of the basic variables from the nonbasic ones. */
+  void computeBasicValues();
+
+  /** Exchanges the basic variable of row r with the nonbasic one of column c. */
+  void pivot(int r, int c);
+
+  /** The allowed violation of a bound b. */
+  static double tolerance(double b) { return s_primalTolerance * (1 + std::abs(b)); }
+
+  /**
+   * The derivative of the sum of infeasibilities with respect to the value of
+   * the variable at position p: -1 below its lower bound, 1 above its upper
+   * bound and 0 otherwise.
+   */
+  int infeasibility(int p) const;
+
+  static const double s_primalTolerance;
+  static const double s_dualTolerance;
+  static const double s_pivotTolerance;
+  static const double s_dropTolerance;
+  /** Bland's rule is used after this many degenerate pivots in a row. */
+  static const int s_degenerateLimit;
+  /** The basic values are recomputed every this many pivots. */
+  static const int s_refreshPeriod;
+
+  int d_numRows;
+  int d_numCols;
+
+  /** How far the bounds of some variables are moved inwards. */
+  DenseMap<double> d_margins;
+
+  /** The arith variable at each position, and the position of each variable. */
+  std::vector<ArithVar> d_arithVars;
+  DenseMap<int> d_positions;
+
+  /** The bounds and the current value of each position. */
+  std::vector<double> d_lower;
+  std::vector<double> d_upper;
+  std::vector<double> d_values;
+
+  /** The position of the basic variable of each row. */
+  std::vector<int> d_basic;
+  /** The position of the nonbasic variable of each column. */
+  std::vector<int> d_nonbasic;
+  /** Whether the variable at each position is basic. */
+  std::vector<bool> d_isBasic;
+
+  /**
+   * The tableau in row major order: the basic variable of row r is the sum
+   * over the columns c of d_tableau[r * d_numCols + c] times the nonbasic
+   * variable of column c.
+   */
+  std::vector<double> d_tableau;
+
+  /** Scratch space for the reduced costs and for pivoting. */
+  std::vector<double> d_reducedCosts;
+  std::vector<int> d_pivotRowSupport;
+
+  bool d_solvedRelaxation;
+};
+
+const double ApproxFloat::s_primalTolerance = 1e-9;
+const double ApproxFloat::s_dualTolerance = 1e-9;
+const double ApproxFloat::s_pivotTolerance = 1e-7;
+const double ApproxFloat::s_dropTolerance = 1e-12;
+const int ApproxFloat::s_degenerateLimit = 50;
+const int ApproxFloat::s_refreshPeriod = 100;
+
+ApproxFloat::ApproxFloat(const ArithVariables& v,
+                         TreeLog& l,
+                         ApproximateStatistics& s,
+                         const DenseMap<double>& margins)
+    : ApproximateSimplex(v, l, s),
+      d_numRows(0),
+      d_numCols(0),
+      d_margins(margins),
+      d_solvedRelaxation(false)
+{
+  for (ArithVariables::var_iterator vi = d_vars.var_begin(),
+                                    vi_end = d_vars.var_end();
+       vi != vi_end;
+       ++vi)
+  {
+    if (d_vars.isAuxiliary(*vi))
+    {
+      ++d_numRows;
+    }
+    else
+    {
+      ++d_numCols;
+    }
+  }
+}
+
+bool ApproxFloat::buildTableau()
+{
+  const double inf = std::numeric_limits<double>::infinity();
+  int numVars = d_numRows + d_numCols;
+  d_arithVars.resize(numVars);
+  d_lower.assign(numVars, -inf);
+  d_upper.assign(numVars, inf);
+  d_values.assign(numVars, 0.0);
+  d_isBasic.assign(numVars, false);
+  d_basic.clear();
+  d_nonbasic.clear();
+  d_positions.purge();
+
+  // The auxiliary variables are basic in the rows, the others are in the
+  // columns
+  for (ArithVariables::var_iterator vi = d_vars.var_begin(),
+                                    vi_end = d_vars.var_end();
+       vi != vi_end;
+       ++vi)
+  {
+    ArithVar v = *vi;
+    int p = d_basic.size() + d_nonbasic.size();
+    d_arithVars[p] = v;
+    d_positions.set(v, p);
+    if (d_vars.hasLowerBound(v))
+    {
+      d_lower[p] = d_vars.getLowerBound(v).approx(SMALL_FIXED_DELTA);
+    }
+    if (d_vars.hasUpperBound(v))
+    {
+      d_upper[p] = d_vars.getUpperBound(v).approx(SMALL_FIXED_DELTA);
+    }
+    if (d_margins.isKey(v))
+    {
+      d_lower[p] += d_margins[v];
+      d_upper[p] -= d_margins[v];
+    }
+    if (d_lower[p] > d_upper[p])
+    {
+      return false;
+    }
+    if (d_vars.isAuxiliary(v))
+    {
+      d_isBasic[p] = true;
+      d_basic.push_back(p);
+    }
+    else
+    {
+      // Nonbasic variables start at their current value, inside their bounds
+      double value = d_vars.getAssignment(v).approx(SMALL_FIXED_DELTA);
+      d_values[p] = std::min(std::max(value, d_lower[p]), d_upper[p]);
+      d_nonbasic.push_back(p);
+    }
+  }
+
+  std::vector<int> columns(numVars, -1);
+  for (int c = 0; c < d_numCols; ++c)
+  {
+    columns[d_nonbasic[c]] = c;
+  }
+  d_tableau.assign(size_t(d_numRows) * d_numCols, 0.0);
+  for (int r = 0; r < d_numRows; ++r)
+  {
+    double* row = &d_tableau[size_t(r) * d_numCols];
+    Polynomial p =
+        Polynomial::parsePolynomial(d_vars.asNode(d_arithVars[d_basic[r]]));
+    for (Polynomial::iterator i = p.begin(), end = p.end(); i != end; ++i)
+    {
+      const Monomial& mono = *i;
+      Node n = mono.getVarList().getNode();
+      Assert(d_vars.hasArithVar(n));
+      int c = columns[d_positions[d_vars.asArithVar(n)]];
+      Assert(c >= 0);
+      row[c] = mono.getConstant().getValue().getDouble();
+    }
+  }
+  d_reducedCosts.assign(d_numCols, 0.0);
+  computeBasicValues();
+  return true;
+}
+
+void ApproxFloat::computeBasicValues()
+{
+  for (int r = 0; r < d_numRows; ++r)
+  {
+    const double* row = &d_tableau[size_t(r) * d_numCols];
+    double value = 0.0;
+    for (int c = 0; c < d_numCols; ++c)
+    {
+      if (row[c] != 0.0)
+      {
+        value += row[c] * d_values[d_nonbasic[c]];
+      }
+    }
+    d_values[d_basic[r]] = value;
+  }
+}
+
+void ApproxFloat::pivot(int r, int c)
+{
+  double* pivotRow = &d_tableau[size_t(r) * d_numCols];
+  double inverse = 1.0 / pivotRow[c];
+
+  // Solve row r for the entering variable
+  d_pivotRowSupport.clear();
+  for (int j = 0; j < d_numCols; ++j)
+  {
+    if (j != c && pivotRow[j] != 0.0)
+    {
+      pivotRow[j] = -pivotRow[j] * inverse;
+      d_pivotRowSupport.push_back(j);
+    }
+  }
+  pivotRow[c] = inverse;
+
+  // and substitute it in the other rows
+  for (int i = 0; i < d_numRows; ++i)
+  {
+    double* row = &d_tableau[size_t(i) * d_numCols];
+    double a = row[c];
+    if (i == r || a == 0.0)
+    {
+      continue;
+    }
+    for (int j : d_pivotRowSupport)
+    {
+      row[j] += a * pivotRow[j];
+      if (std::abs(row[j]) < s_dropTolerance)
+      {
+        row[j] = 0.0;
+      }
+    }
+    row[c] = a * inverse;
+  }
+
+  int leaving = d_basic[r];
+  int entering = d_nonbasic[c];
+  d_basic[r] = entering;
+  d_nonbasic[c] = leaving;
+  d_isBasic[entering] = true;
+  d_isBasic[leaving] = false;
+}
+
+int ApproxFloat::infeasibility(int p) const
+{
+  double value = d_values[p];
+  if (value < d_lower[p] - tolerance(d_lower[p]))
+  {
+    return -1;
+  }
+  else if (value > d_upper[p] + tolerance(d_upper[p]))
+  {
+    return 1;
+  }
+  return 0;
+}
+
+LinResult ApproxFloat::solveRelaxation()
+{
+  d_solvedRelaxation = false;
+  if (d_numRows == 0 || d_numCols == 0
+      || size_t(d_numRows) * d_numCols
+             > options::floatRelaxationMaxEntries())
+  {
+    return LinUnknown;
+  }
+  if (!buildTableau())
+  {
+    return LinUnknown;
+  }
+
+  int iterations = 0;
+  int degenerate = 0;
+  for (;;)
+  {
+    // Reduced costs of the sum of infeasibilities
+    bool infeasible = false;
+    std::fill(d_reducedCosts.begin(), d_reducedCosts.end(), 0.0);
+    for (int r = 0; r < d_numRows; ++r)
+    {
+      int sgn = infeasibility(d_basic[r]);
+      if (sgn != 0)
+      {
+        infeasible = true;
+        const double* row = &d_tableau[size_t(r) * d_numCols];
+        for (int c = 0; c < d_numCols; ++c)
+        {
+          d_reducedCosts[c] += sgn * row[c];
+        }
+      }
+    }
+    if (!infeasible)
+    {
+      Debug("approx::float") << "feasible after " << iterations << endl;
+      d_solvedRelaxation = true;
+      return LinFeasible;
+    }
+
+    // Pricing
+    bool bland = degenerate >= s_degenerateLimit;
+    int enter = -1;
+    int dir = 0;
+    double best = 0.0;
+    for (int c = 0; c < d_numCols; ++c)
+    {
+      int p = d_nonbasic[c];
+      double rc = d_reducedCosts[c];
+      int cdir;
+      if (rc < -s_dualTolerance && d_values[p] < d_upper[p])
+      {
+        cdir = 1;
+      }
+      else if (rc > s_dualTolerance && d_values[p] > d_lower[p])
+      {
+        cdir = -1;
+      }
+      else
+      {
+        continue;
+      }
+      bool better = bland ? (enter < 0 || p < d_nonbasic[enter])
+                          : std::abs(rc) > best;
+      if (better)
+      {
+        enter = c;
+        dir = cdir;
+        best = std::abs(rc);
+      }
+    }
+    if (enter < 0)
+    {
+      Debug("approx::float") << "infeasible after " << iterations << endl;
+      d_solvedRelaxation = true;
+      return LinInfeasible;
+    }
+    if (iterations >= d_pivotLimit)
+    {
+      return LinExhausted;
+    }
+    ++iterations;
+
+    // Ratio test: stop at the first basic variable that reaches a bound
+    int entering = d_nonbasic[enter];
+    double step = dir > 0 ? d_upper[entering] - d_values[entering]
+                          : d_values[entering] - d_lower[entering];
+    int leave = -1;
+    double leaveAt = 0.0;
+    double leaveRate = 0.0;
+    for (int r = 0; r < d_numRows; ++r)
+    {
+      double rate = dir * d_tableau[size_t(r) * d_numCols + enter];
+      if (std::abs(rate) <= s_pivotTolerance)
+      {
+        continue;
+      }
+      int p = d_basic[r];
+      double value = d_values[p];
+      double bound;
+      if (rate > 0)
+      {
+        if (value < d_lower[p] - tolerance(d_lower[p]))
+        {
+          bound = d_lower[p];
+        }
+        else if (value <= d_upper[p] + tolerance(d_upper[p])
+                 && d_upper[p] < std::numeric_limits<double>::infinity())
+        {
+          bound = d_upper[p];
+        }
+        else
+        {
+          continue;
+        }
+      }
+      else
+      {
+        if (value > d_upper[p] + tolerance(d_upper[p]))
+        {
+          bound = d_upper[p];
+        }
+        else if (value >= d_lower[p] - tolerance(d_lower[p])
+                 && d_lower[p] > -std::numeric_limits<double>::infinity())
+        {
+          bound = d_lower[p];
+        }
+        else
+        {
+          continue;
+        }
+      }
+      double ratio = std::max(0.0, (bound - value) / rate);
+      bool better = ratio < step;
+      if (ratio == step && leave >= 0)
+      {
+        better = bland ? p < d_basic[leave]
+                       : std::abs(rate) > std::abs(leaveRate);
+      }
+      if (better)
+      {
+        step = ratio;
+        leave = r;
+        leaveAt = bound;
+        leaveRate = rate;
+      }
+    }
+    if (step == std::numeric_limits<double>::infinity())
+    {
+      // Only possible through rounding errors
+      return LinUnknown;
+    }
+    degenerate = step <= s_primalTolerance ? degenerate + 1 : 0;
+
+    double delta = dir * step;
+    d_values[entering] += delta;
+    for (int r = 0; r < d_numRows; ++r)
+    {
+      double a = d_tableau[size_t(r) * d_numCols + enter];
+      if (a != 0.0)
+      {
+        d_values[d_basic[r]] += a * delta;
+      }
+    }
+    if (leave < 0)
+    {
+      // Bound flip
+      d_values[entering] = dir > 0 ? d_upper[entering] : d_lower[entering];
+    }
+    else
+    {
+      d_values[d_basic[leave]] = leaveAt;
+      pivot(leave, enter);
+      if (iterations % s_refreshPeriod == 0)
+      {
+        computeBasicValues();
+      }
+    }
+  }
+}
+
+ApproximateSimplex::Solution ApproxFloat::extractRelaxation() const
+{
+  Assert(d_solvedRelaxation);
+  Solution sol;
+  for (size_t p = 0, N = d_arithVars.size(); p < N; ++p)
+  {
+    ArithVar v = d_arithVars[p];
+    if (d_isBasic[p])
+    {
+      sol.newBasis.add(v);
+      sol.newValues.set(v, estimateAssignment(v, d_values[p]));
+    }
+    else if (d_values[p] == d_lower[p])
+    {
+      sol.newValues.set(v, d_vars.getLowerBound(v));
+    }
+    else if (d_values[p] == d_upper[p])
+    {
+      sol.newValues.set(v, d_vars.getUpperBound(v));
+    }
+    else
+    {
+      sol.newValues.set(v, estimateAssignment(v, d_values[p]));
+    }
+  }
+  return sol;
+}
+
+double ApproxFloat::sumInfeasibilities(bool mip) const
+{
+  double infeas = 0.0;
+  for (size_t p = 0, N = d_values.size(); p < N; ++p)
+  {
+    if (d_values[p] < d_lower[p])
+    {
+      infeas += d_lower[p] - d_values[p];
+    }
+    else if (d_values[p] > d_upper[p])
+    {
+      infeas += d_values[p] - d_upper[p];
+    }
+  }
+  return infeas;
+}
+
 }/* CVC4::theory::arith namespace */
 }/* CVC4::theory namespace */
 }/* CVC4 namespace */
@@ -545,6 +1127,10 @@ ApproximateSimplex* ApproximateSimplex::mkApproximateSimplexSolver(const ArithVa
   return new ApproxNoOp(vars, l, s);
 #endif
 }
+ApproximateSimplex* ApproximateSimplex::mkFloatSimplexSolver(const ArithVariables& vars, TreeLog& l, ApproximateStatistics& s,
+                                                             const DenseMap<double>& margins){
+  return new ApproxFloat(vars, l, s, margins);
+}
 bool ApproximateSimplex::enabled() {
 #ifdef CVC4_USE_GLPK
   return true;
@@ -1056,56 +1642,7 @@ ApproximateSimplex::Solution ApproxGLPK::extractSolution(bool mip) const
         newAssign = (isAux ? glp_get_row_prim(prob, glpk_index)
                      :  glp_get_col_prim(prob, glpk_index));
       }
-      const DeltaRational& oldAssign = d_vars.getAssignment(vi);
-
-
-      if(d_vars.hasLowerBound(vi) &&
-         roughlyEqual(newAssign, d_vars.getLowerBound(vi).approx(SMALL_FIXED_DELTA))){
-        //Message() << "  to lb" << endl;
-
-        newValues.set(vi, d_vars.getLowerBound(vi));
-      }else if(d_vars.hasUpperBound(vi) &&
-               roughlyEqual(newAssign, d_vars.getUpperBound(vi).approx(SMALL_FIXED_DELTA))){
-        newValues.set(vi, d_vars.getUpperBound(vi));
-        // Message() << "  to ub" << endl;
-      }else{
-
-        double rounded = round(newAssign);
-        if(roughlyEqual(newAssign, rounded)){
-          // Message() << "roughly equal " << rounded << " " << newAssign << " " << oldAssign << endl;
-          newAssign = rounded;
-        }else{
-          // Message() << "not roughly equal " << rounded << " " << newAssign << " " << oldAssign << endl;
-        }
-
-        DeltaRational proposal;
-        if (Maybe<Rational> maybe_new = estimateWithCFE(newAssign))
-        {
-          proposal = maybe_new.value();
-        }
-        else
-        {
-          // failed to estimate the old value. defaulting to the current.
-          proposal = d_vars.getAssignment(vi);
-        }
-
-        if(roughlyEqual(newAssign, oldAssign.approx(SMALL_FIXED_DELTA))){
-          // Message() << "  to prev value" << newAssign << " " << oldAssign << endl;
-          proposal = d_vars.getAssignment(vi);
-        }
-
-
-        if(d_vars.strictlyLessThanLowerBound(vi, proposal)){
-          //Message() << "  round to lb " << d_vars.getLowerBound(vi) << endl;
-          proposal = d_vars.getLowerBound(vi);
-        }else if(d_vars.strictlyGreaterThanUpperBound(vi, proposal)){
-          //Message() << "  round to ub " << d_vars.getUpperBound(vi) << endl;
-          proposal = d_vars.getUpperBound(vi);
-        }else{
-          //Message() << "  use proposal" << proposal << " " << oldAssign  << endl;
-        }
-        newValues.set(vi, proposal);
-      }
+      newValues.set(vi, estimateAssignment(vi, newAssign));
     }
   }
   return sol;
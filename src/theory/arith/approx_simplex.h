@@ -78,6 +78,15 @@ class ApproximateSimplex{
    * If glpk is disabled, return a subclass that does nothing.
    */
   static ApproximateSimplex* mkApproximateSimplexSolver(const ArithVariables& vars, TreeLog& l, ApproximateStatistics& s);
+
+  /**
+   * Returns the built-in floating point simplex. It does not need glpk, but
+   * it only solves the linear relaxation: the MIP and cut related methods do
+   * nothing.
+   * The bounds of each variable v in margins are moved inwards by margins[v].
+   */
+  static ApproximateSimplex* mkFloatSimplexSolver(const ArithVariables& vars, TreeLog& l, ApproximateStatistics& s,
+                                                  const DenseMap<double>& margins = DenseMap<double>());
   ApproximateSimplex(const ArithVariables& v, TreeLog& l, ApproximateStatistics& s);
   virtual ~ApproximateSimplex(){}
 
@@ -147,6 +156,12 @@ class ApproximateSimplex{
   virtual double sumInfeasibilities(bool mip) const = 0;
 
  protected:
+  /**
+   * Turns the approximate value newAssign of v into an exact value: a bound
+   * of v if it is close to one, and a continued fraction estimate otherwise.
+   */
+  DeltaRational estimateAssignment(ArithVar v, double newAssign) const;
+
   const ArithVariables& d_vars;
   TreeLog& d_log;
   ApproximateStatistics& d_stats;
@@ -118,8 +118,13 @@ Result::Sat AttemptSolutionSDP::attempt(const ApproximateSimplex::Solution& sol)
         }
       }
     }
+    if(toAdd == ARITHVAR_SENTINEL){
+      // The proposed basis is singular, e.g. because it comes from a floating
+      // point solver. Keep the part of it that has been installed so far.
+      Debug("arith::findModel") << "attemptSolution("<< instance <<") singular basis" << endl;
+      break;
+    }
     Assert(toRemove != ARITHVAR_SENTINEL);
-    Assert(toAdd != ARITHVAR_SENTINEL);
 
     Trace("arith::forceNewBasis") << toRemove << " " << toAdd << endl;
     //Message() << toRemove << " " << toAdd << endl;
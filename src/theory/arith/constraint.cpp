@@ -95,6 +95,7 @@ std::ostream& operator<<(std::ostream& o, const ArithProofType apt){
   case TrichotomyAP:  o << "TrichotomyAP"; break;
   case EqualityEngineAP:  o << "EqualityEngineAP"; break;
   case IntHoleAP: o << "IntHoleAP"; break;
+  case NonlinearAP: o << "NonlinearAP"; break;
   default: break;
   }
   return o;
@@ -536,6 +537,10 @@ bool Constraint::hasTrichotomyProof() const {
   return getProofType() == TrichotomyAP;
 }
 
+bool Constraint::hasNonlinearProof() const {
+  return getProofType() == NonlinearAP;
+}
+
 bool Constraint::sanityChecking(Node n) const {
   Comparison cmp = Comparison::parseNormalForm(n);
   Kind k = cmp.comparisonKind();
@@ -1261,6 +1266,35 @@ void Constraint::impliedByIntHole(const ConstraintCPVec& b, bool nowInConflict){
   }
 }
 
+void Constraint::impliedByNonlinear(const ConstraintCPVec& b, bool nowInConflict){
+  Debug("constraints::pf") << "impliedByNonlinear(" << this;
+  if (Debug.isOn("constraints::pf")) {
+    for (const ConstraintCP& p : b)
+    {
+      Debug("constraints::pf") << ", " << p;
+    }
+  }
+  Debug("constraints::pf") << ")" << std::endl;
+
+  Assert(!hasProof());
+  Assert(negationHasProof() == nowInConflict);
+  Assert(allHaveProof(b));
+
+  CDConstraintList& antecedents = d_database->d_antecedents;
+  antecedents.push_back(NullConstraint);
+  for(ConstraintCPVec::const_iterator i=b.begin(), i_end=b.end(); i != i_end; ++i){
+    antecedents.push_back(*i);
+  }
+  AntecedentId antecedentEnd = antecedents.size() - 1;
+
+  d_database->pushConstraintRule(ConstraintRule(this, NonlinearAP, antecedentEnd));
+
+  Assert(inConflict() == nowInConflict);
+  if(Debug.isOn("constraint::conflictCommit") && inConflict()){
+    Debug("constraint::conflictCommit") << "inConflict@impliedByNonlinear " << this << std::endl;
+  }
+}
+
 /*
  * If proofs are off, coeffs == RationalVectorSentinal.
  * If proofs are on,
@@ -1404,7 +1438,8 @@ void Constraint::assertionFringe(ConstraintCPVec& v){
           v[writePos] = vi;
           writePos++;
         }else{
-          Assert(vi->hasTrichotomyProof() || vi->hasFarkasProof() || vi->hasIntHoleProof() );
+          Assert(vi->hasTrichotomyProof() || vi->hasFarkasProof()
+                 || vi->hasIntHoleProof() || vi->hasNonlinearProof());
           AntecedentId p = vi->getEndAntecedent();
 
           ConstraintCP antecedent = antecedents[p];
@@ -1474,7 +1509,8 @@ Node Constraint::externalExplain(AssertionOrder order) const{
   }else if(hasEqualityEngineProof()){
     return d_database->eeExplain(this);
   }else{
-    Assert(hasFarkasProof() || hasIntHoleProof() || hasTrichotomyProof());
+    Assert(hasFarkasProof() || hasIntHoleProof() || hasTrichotomyProof()
+           || hasNonlinearProof());
     Assert(!antecentListIsEmpty());
     //Force the selection of the layer above if the node is
     // assertedToTheTheory()!
@@ -125,6 +125,8 @@ namespace arith {
  * - EqualityEngineAP : This is propagated by the equality engine.
  *                    : Consult this for the proof.
  * - IntHoleAP        : This is currently a catch-all for all integer specific reason.
+ * - NonlinearAP      : This is any entailment that uses the meaning of
+ *                    : non-linear terms, e.g. x >= 2 and y >= 3 => x*y >= 6.
  */
 enum ArithProofType
   { NoAP,
@@ -133,7 +135,8 @@ enum ArithProofType
     FarkasAP,
     TrichotomyAP,
     EqualityEngineAP,
-    IntHoleAP};
+    IntHoleAP,
+    NonlinearAP};
 
 /**
  * The types of constraints.
@@ -517,6 +520,9 @@ class Constraint {
   /** Returns true if the node has a trichotomy proof. */
   bool hasTrichotomyProof() const;
 
+  /** Returns true if the node has a non-linear proof. */
+  bool hasNonlinearProof() const;
+
   /**
    * A sets the constraint to be an internal assumption.
    *
@@ -673,6 +679,16 @@ class Constraint {
    */
   void impliedByIntHole(const ConstraintCPVec& b, bool inConflict);
 
+  /**
+   * Marks a the constraint c as being entailed by b.
+   * The reason has to do with the meaning of non-linear terms, e.g. interval
+   * arithmetic over monomials.
+   *
+   * After calling impliedByNonlinear(), the caller should either raise a
+   * conflict or try call tryToPropagate().
+   */
+  void impliedByNonlinear(const ConstraintCPVec& b, bool inConflict);
+
   /**
    * This is a lemma of the form:
    *   x < d or x = d or x > d
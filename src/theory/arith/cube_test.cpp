@@ -0,0 +1,202 @@
+/*********************                                                        */
+/*! \file cube_test.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The unit cube test for integer arithmetic.
+ **
+ ** The unit cube test for integer arithmetic.
+ **/
+
+#include "theory/arith/cube_test.h"
+
+#include <memory>
+
+#include "base/output.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/arith/normal_form.h"
+#include "theory/arith/partial_model.h"
+
+using namespace std;
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+CubeTest::Statistics::Statistics()
+    : d_attempts("theory::arith::cubeTest::attempts", 0),
+      d_successes("theory::arith::cubeTest::successes", 0),
+      d_reused("theory::arith::cubeTest::reused", 0),
+      d_time("theory::arith::cubeTest::time")
+{
+  smtStatisticsRegistry()->registerStat(&d_attempts);
+  smtStatisticsRegistry()->registerStat(&d_successes);
+  smtStatisticsRegistry()->registerStat(&d_reused);
+  smtStatisticsRegistry()->registerStat(&d_time);
+}
+
+CubeTest::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_attempts);
+  smtStatisticsRegistry()->unregisterStat(&d_successes);
+  smtStatisticsRegistry()->unregisterStat(&d_reused);
+  smtStatisticsRegistry()->unregisterStat(&d_time);
+}
+
+CubeTest::CubeTest(const ArithVariables& vars) : d_vars(vars) {}
+
+bool CubeTest::allInteger() const
+{
+  for (ArithVariables::var_iterator vi = d_vars.var_begin(),
+                                    vi_end = d_vars.var_end();
+       vi != vi_end;
+       ++vi)
+  {
+    if (!d_vars.isInteger(*vi))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CubeTest::findIntegerPoint(TreeLog& tl,
+                                ApproximateStatistics& stats,
+                                ApproximateSimplex::Solution& sol)
+{
+  TimerStat::CodeTimer codeTimer(d_statistics.d_time);
+  if (!allInteger())
+  {
+    return false;
+  }
+  ++d_statistics.d_attempts;
+
+  // The point found last time may still do
+  if (!d_lastPoint.empty() && checkPoint(d_lastPoint, sol))
+  {
+    Debug("arith::cube") << "cube test reused its last point" << endl;
+    ++d_statistics.d_reused;
+    ++d_statistics.d_successes;
+    return true;
+  }
+
+  // Fixed variables keep their value when rounding, so they do not count in
+  // the norms
+  DenseMap<double> margins;
+  for (ArithVariables::var_iterator vi = d_vars.var_begin(),
+                                    vi_end = d_vars.var_end();
+       vi != vi_end;
+       ++vi)
+  {
+    ArithVar v = *vi;
+    if (!d_vars.isAuxiliary(v))
+    {
+      if (!d_vars.boundsAreEqual(v))
+      {
+        margins.set(v, 0.5);
+      }
+      continue;
+    }
+    double norm = 0.0;
+    Polynomial p = Polynomial::parsePolynomial(d_vars.asNode(v));
+    for (Polynomial::iterator i = p.begin(), end = p.end(); i != end; ++i)
+    {
+      const Monomial& mono = *i;
+      Node n = mono.getVarList().getNode();
+      Assert(d_vars.hasArithVar(n));
+      if (!d_vars.boundsAreEqual(d_vars.asArithVar(n)))
+      {
+        norm += std::abs(mono.getConstant().getValue().getDouble());
+      }
+    }
+    margins.set(v, norm / 2);
+  }
+
+  std::unique_ptr<ApproximateSimplex> approx(
+      ApproximateSimplex::mkFloatSimplexSolver(d_vars, tl, stats, margins));
+  approx->setPivotLimit(10000);
+  if (approx->solveRelaxation() != LinFeasible)
+  {
+    Debug("arith::cube") << "cube test found no cube" << endl;
+    return false;
+  }
+  ApproximateSimplex::Solution relaxation = approx->extractRelaxation();
+
+  // Round the centre of the cube
+  DenseMap<Rational> point;
+  for (ArithVariables::var_iterator vi = d_vars.var_begin(),
+                                    vi_end = d_vars.var_end();
+       vi != vi_end;
+       ++vi)
+  {
+    ArithVar v = *vi;
+    if (!d_vars.isAuxiliary(v))
+    {
+      const Rational& q = relaxation.newValues[v].getNoninfinitesimalPart();
+      point.set(v, Rational((q + Rational(1, 2)).floor()));
+    }
+  }
+  if (!checkPoint(point, sol))
+  {
+    Debug("arith::cube") << "cube test rounded to a bad point" << endl;
+    return false;
+  }
+  Debug("arith::cube") << "cube test found an integer point" << endl;
+  ++d_statistics.d_successes;
+  d_lastPoint = point;
+  return true;
+}
+
+bool CubeTest::checkPoint(const DenseMap<Rational>& point,
+                          ApproximateSimplex::Solution& sol) const
+{
+  ApproximateSimplex::Solution candidate;
+  for (ArithVariables::var_iterator vi = d_vars.var_begin(),
+                                    vi_end = d_vars.var_end();
+       vi != vi_end;
+       ++vi)
+  {
+    ArithVar v = *vi;
+    Rational value;
+    if (d_vars.isAuxiliary(v))
+    {
+      Polynomial p = Polynomial::parsePolynomial(d_vars.asNode(v));
+      for (Polynomial::iterator i = p.begin(), end = p.end(); i != end; ++i)
+      {
+        const Monomial& mono = *i;
+        ArithVar x = d_vars.asArithVar(mono.getVarList().getNode());
+        if (!point.isKey(x))
+        {
+          return false;
+        }
+        value.addProduct(mono.getConstant().getValue(), point[x]);
+      }
+      candidate.newBasis.add(v);
+    }
+    else
+    {
+      if (!point.isKey(v) || !point[v].isIntegral())
+      {
+        return false;
+      }
+      value = point[v];
+    }
+    DeltaRational dr(value);
+    if (d_vars.strictlyLessThanLowerBound(v, dr)
+        || d_vars.strictlyGreaterThanUpperBound(v, dr))
+    {
+      return false;
+    }
+    candidate.newValues.set(v, dr);
+  }
+  sol = candidate;
+  return true;
+}
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
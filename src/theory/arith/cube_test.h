@@ -0,0 +1,89 @@
+/*********************                                                        */
+/*! \file cube_test.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The unit cube test for integer arithmetic.
+ **
+ ** If the bounds of every row are moved inwards by half the 1-norm of the
+ ** row, any rational point of the smaller polytope rounds to an integer
+ ** point of the original one (Bromberger and Weidenbach, "Fast cube tests
+ ** for LIA constraint solving", IJCAR 2016). Problems with a large feasible
+ ** region often have such a point, and finding it takes one LP instead of
+ ** many branches.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__ARITH__CUBE_TEST_H
+#define CVC4__THEORY__ARITH__CUBE_TEST_H
+
+#include "theory/arith/approx_simplex.h"
+#include "theory/arith/arithvar.h"
+#include "util/dense_map.h"
+#include "util/rational.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+class ArithVariables;
+class TreeLog;
+
+class CubeTest {
+ public:
+  CubeTest(const ArithVariables& vars);
+
+  /**
+   * Looks for an integer point that satisfies the current bounds of all the
+   * variables. This first tries the point found by the previous call, and
+   * then solves the relaxation with the tightened bounds using the floating
+   * point simplex. Every variable, auxiliary ones included, has to be
+   * integer.
+   *
+   * On success returns true, and sol holds the point with the auxiliary
+   * variables as the basis.
+   */
+  bool findIntegerPoint(TreeLog& tl,
+                        ApproximateStatistics& stats,
+                        ApproximateSimplex::Solution& sol);
+
+ private:
+  /**
+   * Is every original variable of the point integral, and does the point
+   * satisfy all the bounds? If so sol is set to it.
+   */
+  bool checkPoint(const DenseMap<Rational>& point,
+                  ApproximateSimplex::Solution& sol) const;
+
+  /** Do all variables have an integer type? */
+  bool allInteger() const;
+
+  const ArithVariables& d_vars;
+
+  /** The point of the last successful call, on the original variables. */
+  DenseMap<Rational> d_lastPoint;
+
+  class Statistics {
+   public:
+    IntStat d_attempts;
+    IntStat d_successes;
+    IntStat d_reused;
+    TimerStat d_time;
+
+    Statistics();
+    ~Statistics();
+  };
+  Statistics d_statistics;
+}; /* class CubeTest */
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__ARITH__CUBE_TEST_H */
@@ -213,6 +213,13 @@ public:
     return *(this);
   }
 
+  /** this += d * a, without temporaries (see Rational::addProduct()) */
+  DeltaRational& addProduct(const DeltaRational& d, const CVC4::Rational& a){
+    c.addProduct(d.c, a);
+    k.addProduct(d.k, a);
+    return *(this);
+  }
+
   DeltaRational& operator+=(const DeltaRational& other){
     c += other.c;
     k += other.k;
@@ -36,6 +36,7 @@ DioSolver::DioSolver(context::Context* ctxt)
     : d_lastUsedProofVariable(ctxt, 0),
       d_inputConstraints(ctxt),
       d_nextInputConstraintToEnqueue(ctxt, 0),
+      d_inputsPushed(0),
       d_trail(ctxt),
       d_subs(ctxt),
       d_currentF(),
@@ -165,6 +166,7 @@ void DioSolver::pushInputConstraint(const Comparison& eq, Node reason){
 
   size_t posInConstraintList = d_inputConstraints.size();
   d_inputConstraints.push_back(InputConstraint(reason, posInTrail));
+  ++d_inputsPushed;
 
   d_varToInputConstraintMap[proofVariable.getNode()] = posInConstraintList;
 }
@@ -65,6 +65,12 @@ private:
    */
   context::CDO<size_t> d_nextInputConstraintToEnqueue;
 
+  /**
+   * The number of calls to pushInputConstraint() so far, including the ones
+   * whose constraint has been popped since.
+   */
+  uint64_t d_inputsPushed;
+
 
   /**
    * We maintain a map from the variables associated with proofs to an input constraint.
@@ -211,6 +217,14 @@ public:
    */
   SumPair processEquationsForCut();
 
+  /**
+   * Identifies the current list of input constraints: if two calls return
+   * the same key, the list was the same at both times.
+   */
+  std::pair<uint64_t, size_t> getInputKey() const{
+    return std::make_pair(d_inputsPushed, d_inputConstraints.size());
+  }
+
 private:
   /** Returns true if the TrailIndex refers to a element in the trail. */
   bool inRange(TrailIndex i) const{
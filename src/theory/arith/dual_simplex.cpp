@@ -195,6 +195,9 @@ bool DualSimplexDecisionProcedure::searchForFeasibleSolution(uint32_t remainingI
     LinearEqualityModule::VarPreferenceFunction pf = useVarOrderPivot ?
       &LinearEqualityModule::minVarOrder : &LinearEqualityModule::minBoundAndColLength;
 
+    // Bland's rule is left alone so that it still terminates
+    bool boundFlips = options::arithBoundFlips() && !useVarOrderPivot;
+
     //DeltaRational beta_i = d_variables.getAssignment(x_i);
     ArithVar x_j = ARITHVAR_SENTINEL;
 
@@ -213,7 +216,11 @@ bool DualSimplexDecisionProcedure::searchForFeasibleSolution(uint32_t remainingI
         // return true;
       }else{
         const DeltaRational& l_i = d_variables.getLowerBound(x_i);
-        d_linEq.pivotAndUpdate(x_i, x_j, l_i);
+        if(boundFlips){
+          d_linEq.boundFlipOrPivotAndUpdate(x_i, x_j, l_i);
+        }else{
+          d_linEq.pivotAndUpdate(x_i, x_j, l_i);
+        }
       }
     }else if(d_variables.cmpAssignmentUpperBound(x_i) > 0){
       x_j = d_linEq.selectSlackLowerBound(x_i, pf);
@@ -228,7 +235,11 @@ bool DualSimplexDecisionProcedure::searchForFeasibleSolution(uint32_t remainingI
         // return true;
       }else{
         const DeltaRational& u_i = d_variables.getUpperBound(x_i);
-        d_linEq.pivotAndUpdate(x_i, x_j, u_i);
+        if(boundFlips){
+          d_linEq.boundFlipOrPivotAndUpdate(x_i, x_j, u_i);
+        }else{
+          d_linEq.pivotAndUpdate(x_i, x_j, u_i);
+        }
       }
     }
     Assert(x_j != ARITHVAR_SENTINEL);
@@ -0,0 +1,442 @@
+/*********************                                                        */
+/*! \file interval_propagator.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Interval constraint propagation through non-linear monomials.
+ **
+ ** Interval constraint propagation through non-linear monomials.
+ **/
+
+#include "theory/arith/interval_propagator.h"
+
+#include <algorithm>
+
+#include "base/output.h"
+#include "options/arith_options.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/arith/constraint.h"
+#include "theory/arith/partial_model.h"
+
+using namespace std;
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+namespace {
+
+/** An end of an interval, d_inf is -1 or 1 if it is -infinity or infinity */
+struct Ext
+{
+  int d_inf;
+  Rational d_value;
+};
+
+Ext mkFinite(const Rational& r)
+{
+  Ext e;
+  e.d_inf = 0;
+  e.d_value = r;
+  return e;
+}
+
+Ext mkInfinite(int sgn)
+{
+  Ext e;
+  e.d_inf = sgn;
+  return e;
+}
+
+int sgn(const Ext& a) { return a.d_inf != 0 ? a.d_inf : a.d_value.sgn(); }
+
+bool less(const Ext& a, const Ext& b)
+{
+  if (a.d_inf != 0 || b.d_inf != 0)
+  {
+    return a.d_inf < b.d_inf;
+  }
+  return a.d_value < b.d_value;
+}
+
+/** The product of the ends, with 0 * infinity = 0 as interval ends */
+Ext mul(const Ext& a, const Ext& b)
+{
+  int sa = sgn(a);
+  int sb = sgn(b);
+  if (sa == 0 || sb == 0)
+  {
+    return mkFinite(Rational(0));
+  }
+  if (a.d_inf != 0 || b.d_inf != 0)
+  {
+    return mkInfinite(sa * sb);
+  }
+  return mkFinite(a.d_value * b.d_value);
+}
+
+struct Interval
+{
+  Ext d_lo;
+  Ext d_hi;
+};
+
+Interval mul(const Interval& a, const Interval& b)
+{
+  Ext c[4] = {mul(a.d_lo, b.d_lo),
+              mul(a.d_lo, b.d_hi),
+              mul(a.d_hi, b.d_lo),
+              mul(a.d_hi, b.d_hi)};
+  Interval res;
+  res.d_lo = c[0];
+  res.d_hi = c[0];
+  for (unsigned i = 1; i < 4; ++i)
+  {
+    if (less(c[i], res.d_lo))
+    {
+      res.d_lo = c[i];
+    }
+    if (less(res.d_hi, c[i]))
+    {
+      res.d_hi = c[i];
+    }
+  }
+  return res;
+}
+
+/** The interval of a^e, tighter than multiplying a by itself */
+Interval pow(const Interval& a, unsigned e)
+{
+  if (e == 1)
+  {
+    return a;
+  }
+  Ext lo = a.d_lo;
+  Ext hi = a.d_hi;
+  for (unsigned i = 1; i < e; ++i)
+  {
+    lo = mul(lo, a.d_lo);
+    hi = mul(hi, a.d_hi);
+  }
+  Interval res;
+  if (e % 2 == 1 || sgn(a.d_lo) >= 0)
+  {
+    res.d_lo = lo;
+    res.d_hi = hi;
+  }
+  else if (sgn(a.d_hi) <= 0)
+  {
+    res.d_lo = hi;
+    res.d_hi = lo;
+  }
+  else
+  {
+    res.d_lo = mkFinite(Rational(0));
+    res.d_hi = less(lo, hi) ? hi : lo;
+  }
+  return res;
+}
+
+/** Is 0 not in a? */
+bool excludesZero(const Interval& a)
+{
+  return sgn(a.d_lo) > 0 || sgn(a.d_hi) < 0;
+}
+
+/** The interval of 1/x for x in a, if a excludes 0 */
+Interval reciprocal(const Interval& a)
+{
+  Assert(excludesZero(a));
+  Interval res;
+  res.d_lo = a.d_hi.d_inf != 0 ? mkFinite(Rational(0))
+                               : mkFinite(Rational(1) / a.d_hi.d_value);
+  res.d_hi = a.d_lo.d_inf != 0 ? mkFinite(Rational(0))
+                               : mkFinite(Rational(1) / a.d_lo.d_value);
+  return res;
+}
+
+}  // namespace
+
+IntervalPropagator::Statistics::Statistics()
+    : d_revisions("theory::arith::icp::revisions", 0),
+      d_propagations("theory::arith::icp::propagations", 0),
+      d_conflicts("theory::arith::icp::conflicts", 0),
+      d_time("theory::arith::icp::time")
+{
+  smtStatisticsRegistry()->registerStat(&d_revisions);
+  smtStatisticsRegistry()->registerStat(&d_propagations);
+  smtStatisticsRegistry()->registerStat(&d_conflicts);
+  smtStatisticsRegistry()->registerStat(&d_time);
+}
+
+IntervalPropagator::Statistics::~Statistics()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_revisions);
+  smtStatisticsRegistry()->unregisterStat(&d_propagations);
+  smtStatisticsRegistry()->unregisterStat(&d_conflicts);
+  smtStatisticsRegistry()->unregisterStat(&d_time);
+}
+
+IntervalPropagator::IntervalPropagator(const ArithVariables& vars,
+                                       ConstraintDatabase& db)
+    : d_vars(vars), d_database(db)
+{
+}
+
+void IntervalPropagator::addMonomial(
+    ArithVar m, const std::vector<std::pair<ArithVar, unsigned> >& factors)
+{
+  Assert(!d_factors.isKey(m));
+  d_factors.set(m, factors);
+  for (const std::pair<ArithVar, unsigned>& f : factors)
+  {
+    if (!d_occurrences.isKey(f.first))
+    {
+      d_occurrences.set(f.first, std::vector<ArithVar>());
+    }
+    d_occurrences.get(f.first).push_back(m);
+  }
+}
+
+IntervalPropagator::Bound IntervalPropagator::getBound(ArithVar v,
+                                                       bool upper) const
+{
+  const DenseMap<Bound>& implied = upper ? d_upper : d_lower;
+  if (implied.isKey(v))
+  {
+    return implied[v];
+  }
+  Bound b;
+  b.d_reason = NullConstraint;
+  // a strict bound is relaxed to the non-strict one
+  if (upper && d_vars.hasUpperBound(v))
+  {
+    b.d_value = d_vars.getUpperBound(v).getNoninfinitesimalPart();
+    b.d_reason = d_vars.getUpperBoundConstraint(v);
+  }
+  else if (!upper && d_vars.hasLowerBound(v))
+  {
+    b.d_value = d_vars.getLowerBound(v).getNoninfinitesimalPart();
+    b.d_reason = d_vars.getLowerBoundConstraint(v);
+  }
+  return b;
+}
+
+void IntervalPropagator::enqueue(ArithVar v)
+{
+  if (d_factors.isKey(v) && !d_queued.isMember(v))
+  {
+    d_queued.add(v);
+    d_queue.push_back(v);
+  }
+  if (d_occurrences.isKey(v))
+  {
+    for (ArithVar m : d_occurrences[v])
+    {
+      if (!d_queued.isMember(m))
+      {
+        d_queued.add(m);
+        d_queue.push_back(m);
+      }
+    }
+  }
+}
+
+ConstraintP IntervalPropagator::propagate(const DenseSet& changed)
+{
+  TimerStat::CodeTimer codeTimer(d_statistics.d_time);
+  for (DenseSet::const_iterator i = changed.begin(), i_end = changed.end();
+       i != i_end;
+       ++i)
+  {
+    enqueue(*i);
+  }
+  unsigned budget = options::arithIcpRevisions();
+  ConstraintP conflict = NullConstraint;
+  while (!d_queue.empty() && conflict == NullConstraint && budget > 0)
+  {
+    --budget;
+    ArithVar m = d_queue.back();
+    d_queue.pop_back();
+    d_queued.remove(m);
+    conflict = revise(m);
+  }
+  Debug("arith::icp") << "icp: " << d_queue.size() << " revisions left"
+                      << std::endl;
+  d_queue.clear();
+  d_queued.purge();
+  d_lower.purge();
+  d_upper.purge();
+  return conflict;
+}
+
+ConstraintP IntervalPropagator::imply(ArithVar v,
+                                      bool upper,
+                                      const Rational& c,
+                                      const ConstraintCPVec& exp)
+{
+  Bound current = getBound(v, upper);
+  Rational value = c;
+  if (d_vars.isInteger(v))
+  {
+    value = upper ? Rational(c.floor()) : Rational(c.ceiling());
+  }
+  if (current.d_reason != NullConstraint
+      && (upper ? value >= current.d_value : value <= current.d_value))
+  {
+    return NullConstraint;
+  }
+  ConstraintP implied = d_database.getBestImpliedBound(
+      v, upper ? UpperBound : LowerBound, DeltaRational(value));
+  if (implied == NullConstraint || implied->hasProof())
+  {
+    return NullConstraint;
+  }
+  Debug("arith::icp") << "icp: " << implied << " from " << exp.size()
+                      << " bounds" << std::endl;
+  if (implied->negationHasProof())
+  {
+    implied->impliedByNonlinear(exp, true);
+    ++d_statistics.d_conflicts;
+    return implied;
+  }
+  implied->impliedByNonlinear(exp, false);
+  implied->tryToPropagate();
+  ++d_statistics.d_propagations;
+
+  Bound b;
+  b.d_value = implied->getValue().getNoninfinitesimalPart();
+  b.d_reason = implied;
+  if (current.d_reason == NullConstraint
+      || (upper ? b.d_value < current.d_value : b.d_value > current.d_value))
+  {
+    (upper ? d_upper : d_lower).set(v, b);
+    enqueue(v);
+  }
+  return NullConstraint;
+}
+
+ConstraintP IntervalPropagator::revise(ArithVar m)
+{
+  ++d_statistics.d_revisions;
+  const std::vector<std::pair<ArithVar, unsigned> >& factors = d_factors[m];
+
+  // the interval of the power of each factor, and the bounds it relies on
+  std::vector<Interval> powers;
+  std::vector<ConstraintCPVec> reasons;
+  for (const std::pair<ArithVar, unsigned>& f : factors)
+  {
+    Interval x;
+    ConstraintCPVec r;
+    Bound lo = getBound(f.first, false);
+    Bound hi = getBound(f.first, true);
+    x.d_lo = lo.d_reason == NullConstraint ? mkInfinite(-1)
+                                           : mkFinite(lo.d_value);
+    x.d_hi = hi.d_reason == NullConstraint ? mkInfinite(1)
+                                           : mkFinite(hi.d_value);
+    if (lo.d_reason != NullConstraint)
+    {
+      r.push_back(lo.d_reason);
+    }
+    if (hi.d_reason != NullConstraint)
+    {
+      r.push_back(hi.d_reason);
+    }
+    powers.push_back(pow(x, f.second));
+    reasons.push_back(r);
+  }
+
+  // forward: m is in the product of the powers
+  Interval prod;
+  prod.d_lo = mkFinite(Rational(1));
+  prod.d_hi = mkFinite(Rational(1));
+  ConstraintCPVec exp;
+  for (unsigned i = 0; i < powers.size(); ++i)
+  {
+    prod = mul(prod, powers[i]);
+    exp.insert(exp.end(), reasons[i].begin(), reasons[i].end());
+  }
+  // a bound that relies on nothing, like x*x >= 0, is left to the lemmas of
+  // the non-linear extension
+  if (!exp.empty())
+  {
+    for (unsigned u = 0; u < 2; ++u)
+    {
+      const Ext& e = u == 1 ? prod.d_hi : prod.d_lo;
+      if (e.d_inf == 0)
+      {
+        ConstraintP conflict = imply(m, u == 1, e.d_value, exp);
+        if (conflict != NullConstraint)
+        {
+          return conflict;
+        }
+      }
+    }
+  }
+
+  // backward: a factor x with exponent 1 is in m divided by the others
+  Bound mlo = getBound(m, false);
+  Bound mhi = getBound(m, true);
+  if (mlo.d_reason == NullConstraint && mhi.d_reason == NullConstraint)
+  {
+    return NullConstraint;
+  }
+  Interval mi;
+  mi.d_lo = mlo.d_reason == NullConstraint ? mkInfinite(-1)
+                                           : mkFinite(mlo.d_value);
+  mi.d_hi = mhi.d_reason == NullConstraint ? mkInfinite(1)
+                                           : mkFinite(mhi.d_value);
+  for (unsigned j = 0; j < factors.size(); ++j)
+  {
+    if (factors[j].second != 1)
+    {
+      continue;
+    }
+    Interval others;
+    others.d_lo = mkFinite(Rational(1));
+    others.d_hi = mkFinite(Rational(1));
+    exp.clear();
+    for (unsigned i = 0; i < powers.size(); ++i)
+    {
+      if (i != j)
+      {
+        others = mul(others, powers[i]);
+        exp.insert(exp.end(), reasons[i].begin(), reasons[i].end());
+      }
+    }
+    if (!excludesZero(others))
+    {
+      continue;
+    }
+    if (mlo.d_reason != NullConstraint)
+    {
+      exp.push_back(mlo.d_reason);
+    }
+    if (mhi.d_reason != NullConstraint)
+    {
+      exp.push_back(mhi.d_reason);
+    }
+    Interval x = mul(mi, reciprocal(others));
+    for (unsigned u = 0; u < 2; ++u)
+    {
+      const Ext& e = u == 1 ? x.d_hi : x.d_lo;
+      if (e.d_inf == 0)
+      {
+        ConstraintP conflict = imply(factors[j].first, u == 1, e.d_value, exp);
+        if (conflict != NullConstraint)
+        {
+          return conflict;
+        }
+      }
+    }
+  }
+  return NullConstraint;
+}
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
@@ -0,0 +1,128 @@
+/*********************                                                        */
+/*! \file interval_propagator.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Interval constraint propagation through non-linear monomials.
+ **
+ ** The linear solver treats every non-linear monomial m = x_1^e_1*...*x_k^e_k
+ ** as a variable of its own. Its bounds and those of the factors are related
+ ** by interval arithmetic, in both directions: the product of the intervals
+ ** of the factors bounds m, and the interval of m divided by the product of
+ ** the other factors bounds a factor with exponent 1 (the HC4 revision of
+ ** Benhamou et al., "Revising hull and box consistency", ICLP 1999). The
+ ** linear parts of the constraints are contracted by the usual row
+ ** propagation of the simplex.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__ARITH__INTERVAL_PROPAGATOR_H
+#define CVC4__THEORY__ARITH__INTERVAL_PROPAGATOR_H
+
+#include <utility>
+#include <vector>
+
+#include "theory/arith/arithvar.h"
+#include "theory/arith/constraint_forward.h"
+#include "util/dense_map.h"
+#include "util/rational.h"
+#include "util/statistics_registry.h"
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+class ArithVariables;
+class ConstraintDatabase;
+
+class IntervalPropagator {
+ public:
+  IntervalPropagator(const ArithVariables& vars, ConstraintDatabase& db);
+
+  /**
+   * Registers the monomial m, given as its distinct factors with their
+   * exponents.
+   */
+  void addMonomial(ArithVar m,
+                   const std::vector<std::pair<ArithVar, unsigned> >& factors);
+
+  /** Have any monomials been registered? */
+  bool hasMonomials() const { return !d_factors.empty(); }
+
+  /**
+   * Revises the monomials that involve the variables in changed, and the
+   * ones that involve the bounds implied by these revisions, up to
+   * options::arithIcpRevisions() revisions.
+   *
+   * A constraint whose bound is implied becomes proven by the bounds it was
+   * computed from and is propagated. Only the constraints that are already in
+   * the database can be implied. Returns a constraint in conflict, or
+   * NullConstraint.
+   */
+  ConstraintP propagate(const DenseSet& changed);
+
+ private:
+  /** An end of an interval, d_reason is null if it is infinite. */
+  struct Bound
+  {
+    Rational d_value;
+    ConstraintCP d_reason;
+  };
+
+  /** The bound of v, the ones implied during this propagate() call first */
+  Bound getBound(ArithVar v, bool upper) const;
+
+  /** Revises the monomial m. Returns a constraint in conflict, if any. */
+  ConstraintP revise(ArithVar m);
+
+  /**
+   * Implies the tightest constraint that follows from the bound v <= c
+   * (upper) or v >= c by exp. Returns the constraint if it is in conflict.
+   */
+  ConstraintP imply(ArithVar v,
+                    bool upper,
+                    const Rational& c,
+                    const ConstraintCPVec& exp);
+
+  /** Schedules the revision of the monomials that involve v. */
+  void enqueue(ArithVar v);
+
+  const ArithVariables& d_vars;
+  ConstraintDatabase& d_database;
+
+  /** The factors of each monomial */
+  DenseMap<std::vector<std::pair<ArithVar, unsigned> > > d_factors;
+  /** The monomials that each variable is a factor of */
+  DenseMap<std::vector<ArithVar> > d_occurrences;
+
+  /** The bounds implied during the current propagate() call */
+  DenseMap<Bound> d_lower;
+  DenseMap<Bound> d_upper;
+
+  /** The monomials to revise */
+  std::vector<ArithVar> d_queue;
+  DenseSet d_queued;
+
+  class Statistics {
+   public:
+    IntStat d_revisions;
+    IntStat d_propagations;
+    IntStat d_conflicts;
+    TimerStat d_time;
+
+    Statistics();
+    ~Statistics();
+  };
+  Statistics d_statistics;
+}; /* class IntervalPropagator */
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__ARITH__INTERVAL_PROPAGATOR_H */
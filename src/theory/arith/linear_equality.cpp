@@ -69,6 +69,7 @@ LinearEqualityModule::LinearEqualityModule(ArithVariables& vars, Tableau& t, Bou
 LinearEqualityModule::Statistics::Statistics():
   d_statPivots("theory::arith::pivots",0),
   d_statUpdates("theory::arith::updates",0),
+  d_statBoundFlips("theory::arith::boundFlips",0),
   d_pivotTime("theory::arith::pivotTime"),
   d_adjTime("theory::arith::adjTime"),
   d_weakeningAttempts("theory::arith::weakening::attempts",0),
@@ -79,6 +80,7 @@ LinearEqualityModule::Statistics::Statistics():
 {
   smtStatisticsRegistry()->registerStat(&d_statPivots);
   smtStatisticsRegistry()->registerStat(&d_statUpdates);
+  smtStatisticsRegistry()->registerStat(&d_statBoundFlips);
 
   smtStatisticsRegistry()->registerStat(&d_pivotTime);
   smtStatisticsRegistry()->registerStat(&d_adjTime);
@@ -93,6 +95,7 @@ LinearEqualityModule::Statistics::Statistics():
 LinearEqualityModule::Statistics::~Statistics(){
   smtStatisticsRegistry()->unregisterStat(&d_statPivots);
   smtStatisticsRegistry()->unregisterStat(&d_statUpdates);
+  smtStatisticsRegistry()->unregisterStat(&d_statBoundFlips);
   smtStatisticsRegistry()->unregisterStat(&d_pivotTime);
   smtStatisticsRegistry()->unregisterStat(&d_adjTime);
 
@@ -214,7 +217,8 @@ void LinearEqualityModule::updateUntracked(ArithVar x_i, const DeltaRational& v)
     const Rational& a_ji = entry.getCoefficient();
 
     const DeltaRational& assignment = d_variables.getAssignment(x_j);
-    DeltaRational  nAssignment = assignment+(diff * a_ji);
+    DeltaRational nAssignment = assignment;
+    nAssignment.addProduct(diff, a_ji);
     d_variables.setAssignment(x_j, nAssignment);
 
     d_basicVariableUpdates(x_j);
@@ -254,7 +258,8 @@ void LinearEqualityModule::updateTracked(ArithVar x_i, const DeltaRational& v){
     const Rational& a_ji = entry.getCoefficient();
 
     const DeltaRational& assignment = d_variables.getAssignment(x_j);
-    DeltaRational  nAssignment = assignment+(diff * a_ji);
+    DeltaRational nAssignment = assignment;
+    nAssignment.addProduct(diff, a_ji);
     Debug("update") << x_j << " " << a_ji << assignment << " -> " << nAssignment << endl;
     BoundCounts xjBefore = d_variables.atBoundCounts(x_j);
     d_variables.setAssignment(x_j, nAssignment);
@@ -275,6 +280,34 @@ void LinearEqualityModule::updateTracked(ArithVar x_i, const DeltaRational& v){
   if(Debug.isOn("paranoid:check_tableau")){  debugCheckTableau(); }
 }
 
+bool LinearEqualityModule::boundFlipOrPivotAndUpdate(ArithVar x_i, ArithVar x_j, const DeltaRational& x_i_value){
+  Assert(x_i != x_j);
+
+  RowIndex ridx = d_tableau.basicToRowIndex(x_i);
+  const Tableau::Entry& entry_ij =  d_tableau.findEntry(ridx, x_j);
+  Assert(!entry_ij.blank());
+
+  const Rational& a_ij = entry_ij.getCoefficient();
+  const DeltaRational& betaX_i = d_variables.getAssignment(x_i);
+  DeltaRational x_j_value =
+    d_variables.getAssignment(x_j) + (x_i_value - betaX_i)/a_ij;
+
+  if(d_variables.strictlyGreaterThanUpperBound(x_j, x_j_value)){
+    Debug("arith::boundFlip") << x_j << " flips to its upper bound" << endl;
+    ++(d_statistics.d_statBoundFlips);
+    update(x_j, d_variables.getUpperBound(x_j));
+    return true;
+  }else if(d_variables.strictlyLessThanLowerBound(x_j, x_j_value)){
+    Debug("arith::boundFlip") << x_j << " flips to its lower bound" << endl;
+    ++(d_statistics.d_statBoundFlips);
+    update(x_j, d_variables.getLowerBound(x_j));
+    return true;
+  }
+
+  pivotAndUpdate(x_i, x_j, x_i_value);
+  return false;
+}
+
 void LinearEqualityModule::pivotAndUpdate(ArithVar x_i, ArithVar x_j, const DeltaRational& x_i_value){
   Assert(x_i != x_j);
 
@@ -475,7 +508,7 @@ DeltaRational LinearEqualityModule::computeRowValue(ArithVar x, bool useSafe) co
     const Rational& coeff = entry.getCoefficient();
 
     const DeltaRational& assignment = d_variables.getAssignment(nonbasic, useSafe);
-    sum = sum + (assignment * coeff);
+    sum.addProduct(assignment, coeff);
   }
   return sum;
 }
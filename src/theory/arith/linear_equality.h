@@ -254,6 +254,16 @@ public:
    */
   void pivotAndUpdate(ArithVar x_i, ArithVar x_j, const DeltaRational& v);
 
+  /**
+   * Like pivotAndUpdate(x_i, x_j, v), with a bound-flipping ratio test: if
+   * moving x_j far enough to bring x_i to v would take x_j past one of its
+   * own bounds, x_j is only moved to that bound and stays nonbasic. This
+   * saves the pivot and the fill-in it causes, at the cost of leaving x_i
+   * short of v.
+   * Returns true if x_j was moved to its bound instead of pivoting.
+   */
+  bool boundFlipOrPivotAndUpdate(ArithVar x_i, ArithVar x_j, const DeltaRational& v);
+
   ArithVariables& getVariables() const{ return d_variables; }
   Tableau& getTableau() const{ return d_tableau; }
 
@@ -703,7 +713,7 @@ private:
   /** These fields are designed to be accessible to TheoryArith methods. */
   class Statistics {
   public:
-    IntStat d_statPivots, d_statUpdates;
+    IntStat d_statPivots, d_statUpdates, d_statBoundFlips;
     TimerStat d_pivotTime;
     TimerStat d_adjTime;
 
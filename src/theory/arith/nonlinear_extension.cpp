@@ -17,6 +17,7 @@
 
 #include "theory/arith/nonlinear_extension.h"
 
+#include <algorithm>
 #include <cmath>
 #include <set>
 
@@ -26,6 +27,7 @@
 #include "theory/arith/arith_msum.h"
 #include "theory/arith/arith_utilities.h"
 #include "theory/arith/theory_arith.h"
+#include "theory/arith/univariate_covering.h"
 #include "theory/ext_theory.h"
 #include "theory/quantifiers/quant_util.h"
 #include "theory/theory_model.h"
@@ -181,6 +183,8 @@ NonlinearExtension::NonlinearExtension(TheoryArith& containing,
       "b", NodeManager::currentNM()->realType());
   d_taylor_degree = options::nlExtTfTaylorDegree();
   d_used_approx = false;
+  d_work_truncated = false;
+  d_work_unlimited = false;
 }
 
 NonlinearExtension::~NonlinearExtension() {}
@@ -2404,9 +2408,11 @@ void NonlinearExtension::check(Theory::Effort e) {
                           << " shared terms with wrong model value."
                           << std::endl;
     bool needsRecheck;
+    d_work_unlimited = false;
     do
     {
       d_used_approx = false;
+      d_work_truncated = false;
       needsRecheck = false;
       Assert(e == Theory::EFFORT_LAST_CALL);
       // complete_status:
@@ -2486,8 +2492,30 @@ void NonlinearExtension::check(Theory::Effort e) {
           }
         }
 
+        // decide the univariate constraints exactly
+        if (options::nlExtCovering())
+        {
+          std::vector<Node> cover_lemmas =
+              checkUnivariateCovering(assertions, false_asserts);
+          num_added_lemmas = flushLemmas(cover_lemmas);
+          if (num_added_lemmas > 0)
+          {
+            Trace("nl-ext") << "...added " << num_added_lemmas
+                            << " univariate covering lemmas." << std::endl;
+            return;
+          }
+        }
+
         // we are incomplete
-        if (options::nlExtIncPrecision() && d_used_approx)
+        if (d_work_truncated)
+        {
+          // the lemma schemas that stopped at the work limit may still find
+          // a lemma, check again without the limit before giving up
+          d_work_unlimited = true;
+          needsRecheck = true;
+          Trace("nl-ext") << "...recheck without the work limit" << std::endl;
+        }
+        else if (options::nlExtIncPrecision() && d_used_approx)
         {
           d_taylor_degree++;
           d_used_approx = false;
@@ -3148,12 +3176,34 @@ std::vector<Node> NonlinearExtension::checkMonomialMagnitude( unsigned c ) {
   std::map<int, std::map<Node, std::map<Node, Node> > > cmp_infers;
   Trace("nl-ext") << "Get monomial comparison lemmas (order=" << r
                   << ", compare=" << c << ")..." << std::endl;
-  for (unsigned j = 0; j < d_ms.size(); j++) {
+  // the work limit is checked between monomials, we start at the monomial
+  // where the previous check stopped
+  unsigned limit = d_work_unlimited ? 0 : options::nlExtWorkLimit();
+  unsigned work = 0;
+  unsigned nms = d_ms.size();
+  unsigned jstart = 0;
+  std::vector<Node>::iterator its =
+      std::find(d_ms.begin(), d_ms.end(), d_magnitude_start[c]);
+  if (its != d_ms.end())
+  {
+    jstart = its - d_ms.begin();
+  }
+  for (unsigned jj = 0; jj < nms; jj++) {
+    unsigned j = (jstart + jj) % nms;
+    if (limit > 0 && work >= limit)
+    {
+      Trace("nl-ext") << "...work limit reached after " << jj << " / " << nms
+                      << " monomials." << std::endl;
+      d_magnitude_start[c] = d_ms[j];
+      d_work_truncated = true;
+      break;
+    }
     Node a = d_ms[j];
     if (d_ms_proc.find(a) == d_ms_proc.end() && 
         d_m_nconst_factor.find( a )==d_m_nconst_factor.end()) {
       if (c == 0) {
         // compare magnitude against 1
+        work++;
         std::vector<Node> exp;
         NodeMultiset a_exp_proc;
         NodeMultiset b_exp_proc;
@@ -3173,6 +3223,7 @@ std::vector<Node> NonlinearExtension::checkMonomialMagnitude( unsigned c ) {
               NodeMultiset a_exp_proc;
               NodeMultiset b_exp_proc;
               if (itmea->second.find(v) != itmea->second.end()) {
+                work++;
                 a_exp_proc[v] = 1;
                 b_exp_proc[v] = 1;
                 setMonomialFactor(a, v, a_exp_proc);
@@ -3192,6 +3243,7 @@ std::vector<Node> NonlinearExtension::checkMonomialMagnitude( unsigned c ) {
               std::map<Node, NodeMultiset>::iterator itmeb =
                   d_m_exp.find(b);
               Assert(itmeb != d_m_exp.end());
+              work++;
 
               std::vector<Node> exp;
               // take common factors of monomials, set minimum of
@@ -3279,6 +3331,116 @@ std::vector<Node> NonlinearExtension::checkMonomialMagnitude( unsigned c ) {
   return nr_lemmas;
 }
 
+std::vector<Node> NonlinearExtension::checkUnivariateCovering(
+    const std::vector<Node>& asserts, const std::vector<Node>& false_asserts)
+{
+  std::vector<Node> lemmas;
+  Trace("nl-ext") << "Get univariate covering lemmas..." << std::endl;
+  NodeManager* nm = NodeManager::currentNM();
+  // the univariate constraints of each variable
+  std::map<Node, UnivariateCovering> covers;
+  std::map<Node, std::vector<Node> > cover_lits;
+  std::map<Node, bool> cover_nl;
+  // the variables that occur in other constraints
+  std::unordered_set<Node, NodeHashFunction> entangled;
+  for (const Node& lit : asserts)
+  {
+    bool polarity = lit.getKind() != NOT;
+    Node atom = polarity ? lit : lit[0];
+    unsigned signs = 0;
+    switch (atom.getKind())
+    {
+      case EQUAL: signs = UnivariateCovering::SIGN_ZERO; break;
+      case GEQ:
+        signs = UnivariateCovering::SIGN_ZERO | UnivariateCovering::SIGN_POS;
+        break;
+      case GT: signs = UnivariateCovering::SIGN_POS; break;
+      case LEQ:
+        signs = UnivariateCovering::SIGN_ZERO | UnivariateCovering::SIGN_NEG;
+        break;
+      case LT: signs = UnivariateCovering::SIGN_NEG; break;
+      default: break;
+    }
+    Node x;
+    UPoly lhs, rhs;
+    if (signs == 0 || !atom[0].getType().isReal()
+        || !UnivariateCovering::mkPolynomial(atom[0], x, lhs)
+        || !UnivariateCovering::mkPolynomial(atom[1], x, rhs) || x.isNull())
+    {
+      expr::getSymbols(atom, entangled);
+      continue;
+    }
+    if (!polarity)
+    {
+      signs = ~signs
+              & (UnivariateCovering::SIGN_NEG | UnivariateCovering::SIGN_ZERO
+                 | UnivariateCovering::SIGN_POS);
+    }
+    // lhs - rhs, the sign is that of the relation
+    UPoly p(std::max(lhs.size(), rhs.size()), Rational(0));
+    for (unsigned i = 0; i < lhs.size(); i++)
+    {
+      p[i] += lhs[i];
+    }
+    for (unsigned i = 0; i < rhs.size(); i++)
+    {
+      p[i] -= rhs[i];
+    }
+    covers[x].addConstraint(p, signs);
+    cover_lits[x].push_back(lit);
+    cover_nl[x] = cover_nl[x] || lhs.size() > 2 || rhs.size() > 2;
+  }
+  for (std::pair<const Node, UnivariateCovering>& c : covers)
+  {
+    Node x = c.first;
+    // linear constraints are decided by the simplex
+    if (!cover_nl[x])
+    {
+      continue;
+    }
+    const std::vector<Node>& lits = cover_lits[x];
+    UnivariateCovering::Result res = c.second.check();
+    if (res == UnivariateCovering::COVERED)
+    {
+      std::vector<Node> conj;
+      for (unsigned i : c.second.getCovering())
+      {
+        conj.push_back(lits[i]);
+      }
+      Node lem = (conj.size() == 1 ? conj[0] : nm->mkNode(AND, conj)).negate();
+      Trace("nl-ext-cover") << "Covering lemma : " << lem << std::endl;
+      lemmas.push_back(lem);
+    }
+    else if (res == UnivariateCovering::SAMPLE
+             && entangled.find(x) == entangled.end()
+             // only an integral sample is a value for an integer variable
+             && (!x.getType().isInteger()
+                 || c.second.getSample().isIntegral()))
+    {
+      bool has_false = false;
+      for (const Node& lit : lits)
+      {
+        if (std::find(false_asserts.begin(), false_asserts.end(), lit)
+            != false_asserts.end())
+        {
+          has_false = true;
+          break;
+        }
+      }
+      if (has_false)
+      {
+        Node eq = Rewriter::rewrite(
+            x.eqNode(nm->mkConst(c.second.getSample())));
+        Node literal = d_containing.getValuation().ensureLiteral(eq);
+        d_containing.getOutputChannel().requirePhase(literal, true);
+        Trace("nl-ext-cover") << "Covering split : " << literal << std::endl;
+        lemmas.push_back(literal.orNode(literal.negate()));
+      }
+    }
+  }
+  return lemmas;
+}
+
 std::vector<Node> NonlinearExtension::checkTangentPlanes() {
   std::vector< Node > lemmas;
   Trace("nl-ext") << "Get monomial tangent plane lemmas..." << std::endl;
@@ -3487,8 +3649,28 @@ std::vector<Node> NonlinearExtension::checkMonomialInferBounds(
   }
 
   Trace("nl-ext") << "Get inferred bound lemmas..." << std::endl;
-  
-  for (unsigned k = 0; k < d_mterms.size(); k++) {
+
+  // as in checkMonomialMagnitude, the work limit is checked between terms
+  unsigned limit = d_work_unlimited ? 0 : options::nlExtWorkLimit();
+  unsigned work = 0;
+  unsigned nmterms = d_mterms.size();
+  unsigned kstart = 0;
+  std::vector<Node>::iterator its =
+      std::find(d_mterms.begin(), d_mterms.end(), d_infer_bounds_start);
+  if (its != d_mterms.end())
+  {
+    kstart = its - d_mterms.begin();
+  }
+  for (unsigned kk = 0; kk < nmterms; kk++) {
+    unsigned k = (kstart + kk) % nmterms;
+    if (limit > 0 && work >= limit)
+    {
+      Trace("nl-ext") << "...work limit reached after " << kk << " / "
+                      << nmterms << " terms." << std::endl;
+      d_infer_bounds_start = d_mterms[k];
+      d_work_truncated = true;
+      break;
+    }
     Node x = d_mterms[k];
     Trace("nl-ext-bound-debug")
         << "Process bounds for " << x << " : " << std::endl;
@@ -3514,6 +3696,7 @@ std::vector<Node> NonlinearExtension::checkMonomialInferBounds(
               Kind type = itcr->second;
               for (unsigned j = 0; j < itm->second.size(); j++) {
                 Node y = itm->second[j];
+                work++;
                 Assert(d_m_contain_mult[x].find(y) !=
                        d_m_contain_mult[x].end());
                 Node mult = d_m_contain_mult[x][y];
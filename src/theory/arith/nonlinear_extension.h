@@ -584,6 +584,21 @@ class NonlinearExtension {
   std::map<Node, std::map<Node, std::map<Node, Node> > > d_ci_exp;
   std::map<Node, std::map<Node, std::map<Node, bool> > > d_ci_max;
 
+  /**
+   * The monomial of d_ms (resp. term of d_mterms) from which the magnitude
+   * lemma schema for each effort level (resp. the inferred bounds lemma
+   * schema) starts in the next check. These are only used when the work of
+   * these schemas is bounded by options::nlExtWorkLimit(), so that successive
+   * checks consider the monomials in a round-robin fashion. They are terms
+   * rather than positions since d_ms is sorted again at every check.
+   */
+  Node d_magnitude_start[3];
+  Node d_infer_bounds_start;
+  /** Whether a lemma schema stopped at the work limit in this check */
+  bool d_work_truncated;
+  /** Whether the work limit is ignored, when checking again before giving up */
+  bool d_work_unlimited;
+
   /** A list of all functions for each kind in { EXPONENTIAL, SINE, POW, PI } */
   std::map<Kind, std::vector<Node> > d_f_map;
 
@@ -878,6 +893,30 @@ class NonlinearExtension {
   */
   std::vector<Node> checkMonomialInferResBounds();
 
+  /** check univariate covering
+  *
+  * Returns a set of valid theory lemmas, based on deciding exactly the
+  * constraints in asserts that are polynomials in a single variable, grouped
+  * by variable, see UnivariateCovering. This is complete for these
+  * constraints, and is only used when the schemas above are stuck.
+  * This schema is not enabled by default, and can be enabled by
+  * --nl-ext-cover.
+  *
+  * If the constraints over x are unsatisfiable, the lemma is the negation
+  * of a subset of them that covers the real line. Otherwise, if x only occurs
+  * in univariate constraints and one of them is false in the model, the
+  * lemma is a split on x = c, for a rational solution c, that is decided
+  * positively first.
+  *
+  * Examples:
+  *
+  *  ~( x*x*x > 2 ^ x < 1 )
+  *  x = 2 V x != 2  ...for x*x = 4 ^ x > 0
+  */
+  std::vector<Node> checkUnivariateCovering(
+      const std::vector<Node>& asserts,
+      const std::vector<Node>& false_asserts);
+
   /** check tangent planes
   *
   * Returns a set of valid theory lemmas, based on an
@@ -17,6 +17,7 @@
 
 #include "theory/arith/theory_arith.h"
 
+#include "options/arith_options.h"
 #include "options/smt_options.h"
 #include "smt/smt_statistics_registry.h"
 #include "theory/arith/infer_bounds.h"
@@ -136,6 +137,9 @@ std::pair<bool, Node> TheoryArith::entailmentCheck (TNode lit,
   if(params == NULL){
     ArithEntailmentCheckParameters* def = new ArithEntailmentCheckParameters();
     def->addLookupRowSumAlgorithms();
+    if(options::arithInferBoundsIncremental()){
+      def->addAlgorithm(inferbounds::InferBoundAlgorithm::mkSimplex(Maybe<int>()));
+    }
     aparams = def;
   }else{
     AlwaysAssert(params->getTheoryId() == getId());
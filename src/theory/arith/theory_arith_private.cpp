@@ -95,6 +95,7 @@ TheoryArithPrivate::TheoryArithPrivate(TheoryArith& containing,
       d_qflraStatus(Result::SAT_UNKNOWN),
       d_unknownsInARow(0),
       d_hasDoneWorkSinceCut(false),
+      d_branchSinceGomoryCut(true),
       d_learner(u),
       d_assertionsThatDoNotMatchTheirLiterals(c),
       d_nextIntegerCheckVar(0),
@@ -132,6 +133,9 @@ TheoryArithPrivate::TheoryArithPrivate(TheoryArith& containing,
           d_linEq, d_errorSet, RaiseConflict(*this), TempVarMalloc(*this)),
       d_attemptSolSimplex(
           d_linEq, d_errorSet, RaiseConflict(*this), TempVarMalloc(*this)),
+      d_cubeTest(d_partialModel),
+      d_cubeTestDue(true),
+      d_icp(d_partialModel, d_constraintDatabase),
       d_nonlinearExtension(NULL),
       d_pass1SDP(NULL),
       d_otherSDP(NULL),
@@ -344,6 +348,8 @@ TheoryArithPrivate::Statistics::Statistics()
   , d_presolveTime("theory::arith::presolveTime")
   , d_newPropTime("theory::arith::newPropTimer")
   , d_externalBranchAndBounds("theory::arith::externalBranchAndBounds",0)
+  , d_gomoryCuts("theory::arith::gomoryCuts",0)
+  , d_dioCutsSkipped("theory::arith::dioCutsSkipped",0)
   , d_initialTableauSize("theory::arith::initialTableauSize", 0)
   , d_currSetToSmaller("theory::arith::currSetToSmaller", 0)
   , d_smallerSetToCurr("theory::arith::smallerSetToCurr", 0)
@@ -351,6 +357,10 @@ TheoryArithPrivate::Statistics::Statistics()
   , d_boundComputationTime("theory::arith::bound::time")
   , d_boundComputations("theory::arith::bound::boundComputations",0)
   , d_boundPropagations("theory::arith::bound::boundPropagations",0)
+  , d_boundRowsScheduled("theory::arith::bound::rowsScheduled",0)
+  , d_boundRowsFiltered("theory::arith::bound::rowsFiltered",0)
+  , d_boundRowsDropped("theory::arith::bound::rowsDropped",0)
+  , d_boundTableauInferences("theory::arith::bound::tableauInferences",0)
   , d_unknownChecks("theory::arith::status::unknowns", 0)
   , d_maxUnknownsInARow("theory::arith::status::maxUnknownsInARow", 0)
   , d_avgUnknownsInARow("theory::arith::status::avgUnknownsInARow")
@@ -421,6 +431,8 @@ TheoryArithPrivate::Statistics::Statistics()
   smtStatisticsRegistry()->registerStat(&d_newPropTime);
 
   smtStatisticsRegistry()->registerStat(&d_externalBranchAndBounds);
+  smtStatisticsRegistry()->registerStat(&d_gomoryCuts);
+  smtStatisticsRegistry()->registerStat(&d_dioCutsSkipped);
 
   smtStatisticsRegistry()->registerStat(&d_initialTableauSize);
   smtStatisticsRegistry()->registerStat(&d_currSetToSmaller);
@@ -430,6 +442,10 @@ TheoryArithPrivate::Statistics::Statistics()
   smtStatisticsRegistry()->registerStat(&d_boundComputationTime);
   smtStatisticsRegistry()->registerStat(&d_boundComputations);
   smtStatisticsRegistry()->registerStat(&d_boundPropagations);
+  smtStatisticsRegistry()->registerStat(&d_boundRowsScheduled);
+  smtStatisticsRegistry()->registerStat(&d_boundRowsFiltered);
+  smtStatisticsRegistry()->registerStat(&d_boundRowsDropped);
+  smtStatisticsRegistry()->registerStat(&d_boundTableauInferences);
 
   smtStatisticsRegistry()->registerStat(&d_unknownChecks);
   smtStatisticsRegistry()->registerStat(&d_maxUnknownsInARow);
@@ -514,6 +530,8 @@ TheoryArithPrivate::Statistics::~Statistics(){
   smtStatisticsRegistry()->unregisterStat(&d_newPropTime);
 
   smtStatisticsRegistry()->unregisterStat(&d_externalBranchAndBounds);
+  smtStatisticsRegistry()->unregisterStat(&d_gomoryCuts);
+  smtStatisticsRegistry()->unregisterStat(&d_dioCutsSkipped);
 
   smtStatisticsRegistry()->unregisterStat(&d_initialTableauSize);
   smtStatisticsRegistry()->unregisterStat(&d_currSetToSmaller);
@@ -523,6 +541,10 @@ TheoryArithPrivate::Statistics::~Statistics(){
   smtStatisticsRegistry()->unregisterStat(&d_boundComputationTime);
   smtStatisticsRegistry()->unregisterStat(&d_boundComputations);
   smtStatisticsRegistry()->unregisterStat(&d_boundPropagations);
+  smtStatisticsRegistry()->unregisterStat(&d_boundRowsScheduled);
+  smtStatisticsRegistry()->unregisterStat(&d_boundRowsFiltered);
+  smtStatisticsRegistry()->unregisterStat(&d_boundRowsDropped);
+  smtStatisticsRegistry()->unregisterStat(&d_boundTableauInferences);
 
   smtStatisticsRegistry()->unregisterStat(&d_unknownChecks);
   smtStatisticsRegistry()->unregisterStat(&d_maxUnknownsInARow);
@@ -1483,10 +1505,31 @@ void TheoryArithPrivate::setupVariableList(const VarList& vl){
     }
 
     ++(d_statistics.d_statUserVariables);
-    requestArithVar(vlNode, false, false);
-    //ArithVar av = requestArithVar(vlNode, false);
+    ArithVar monomial = requestArithVar(vlNode, false, false);
     //setupInitialValue(av);
 
+    if(options::arithIcp()){
+      // the distinct factors with their exponents, equal factors are adjacent
+      std::vector<std::pair<ArithVar, unsigned> > factors;
+      bool allSetup = true;
+      for(VarList::iterator i = vl.begin(), end = vl.end(); i != end; ++i){
+        Node f = (*i).getNode();
+        if(!d_partialModel.hasArithVar(f)){
+          allSetup = false;
+          break;
+        }
+        ArithVar fv = d_partialModel.asArithVar(f);
+        if(!factors.empty() && factors.back().first == fv){
+          ++factors.back().second;
+        }else{
+          factors.push_back(std::make_pair(fv, 1u));
+        }
+      }
+      if(allSetup){
+        d_icp.addMonomial(monomial, factors);
+      }
+    }
+
     markSetup(vlNode);
   }else{
     if( !options::nlExt() ){
@@ -1840,9 +1883,7 @@ Comparison TheoryArithPrivate::mkIntegerEqualityFromAssignment(ArithVar v){
 }
 
 Node TheoryArithPrivate::dioCutting(){
-  context::Context::ScopedPush speculativePush(getSatContext());
-  //DO NOT TOUCH THE OUTPUTSTREAM
-
+  std::vector<std::pair<ArithVar, Integer> > speculation;
   for(var_iterator vi = var_begin(), vend = var_end(); vi != vend; ++vi){
     ArithVar v = *vi;
     if(isInteger(v)){
@@ -1850,20 +1891,42 @@ Node TheoryArithPrivate::dioCutting(){
          d_partialModel.cmpAssignmentLowerBound(v) == 0){
         if(!d_partialModel.boundsAreEqual(v)){
           // If the bounds are equal this is already in the dioSolver
-          //Add v = dr as a speculation.
-          Comparison eq = mkIntegerEqualityFromAssignment(v);
-          Debug("dio::push") << "dio::push " << v << " " <<  eq.getNode() << endl;
-          Assert(!eq.isBoolean());
-          d_diosolver.pushInputConstraint(eq, eq.getNode());
-          // It does not matter what the explanation of eq is.
-          // It cannot be used in a conflict
+          speculation.push_back(
+              make_pair(v, d_partialModel.getAssignment(v).floor()));
         }
       }
     }
   }
 
-  SumPair plane = d_diosolver.processEquationsForCut();
+  // The same speculation over the same input constraints finds no cut again
+  if(speculation == d_lastFailedDioCut &&
+     d_diosolver.getInputKey() == d_lastFailedDioCutKey){
+    ++(d_statistics.d_dioCutsSkipped);
+    return Node::null();
+  }
+
+  SumPair plane = SumPair::mkZero();
+  {
+    context::Context::ScopedPush speculativePush(getSatContext());
+    //DO NOT TOUCH THE OUTPUTSTREAM
+
+    for(size_t i = 0, N = speculation.size(); i < N; ++i){
+      ArithVar v = speculation[i].first;
+      //Add v = dr as a speculation.
+      Comparison eq = mkIntegerEqualityFromAssignment(v);
+      Debug("dio::push") << "dio::push " << v << " " <<  eq.getNode() << endl;
+      Assert(!eq.isBoolean());
+      d_diosolver.pushInputConstraint(eq, eq.getNode());
+      // It does not matter what the explanation of eq is.
+      // It cannot be used in a conflict
+    }
+
+    plane = d_diosolver.processEquationsForCut();
+  }
   if(plane.isZero()){
+    // The key is taken after the speculation has been popped
+    d_lastFailedDioCut.swap(speculation);
+    d_lastFailedDioCutKey = d_diosolver.getInputKey();
     return Node::null();
   }else{
     Polynomial p = plane.getPolynomial();
@@ -1887,6 +1950,110 @@ Node TheoryArithPrivate::dioCutting(){
   }
 }
 
+void TheoryArithPrivate::attemptCubeTest(){
+  if(d_qflraStatus != Result::SAT || !d_cubeTestDue || !safeToCallApprox()){
+    return;
+  }
+  ApproximateSimplex::Solution sol;
+  if(!d_cubeTest.findIntegerPoint(getTreeLog(), getApproxStats(), sol)){
+    d_cubeTestDue = false;
+    return;
+  }
+
+  d_partialModel.stopQueueingBoundCounts();
+  UpdateTrackingCallback utcb(&d_linEq);
+  d_partialModel.processBoundsQueue(utcb);
+  d_linEq.startTrackingBoundCounts();
+
+  importSolution(sol);
+  if(d_qflraStatus != Result::SAT){
+    // The point satisfies all the bounds, so the exact simplex gets there
+    d_qflraStatus = selectSimplex(true).findModel(true);
+  }
+  Assert(d_qflraStatus == Result::SAT);
+
+  d_linEq.stopTrackingBoundCounts();
+  d_partialModel.startQueueingBoundCounts();
+}
+
+Node TheoryArithPrivate::gomoryCutting(){
+  for(var_iterator vi = var_begin(), vend = var_end(); vi != vend; ++vi){
+    ArithVar v = *vi;
+    if(isInteger(v) && d_tableau.isBasic(v) &&
+       !d_partialModel.integralAssignment(v)){
+      Node lemma = gomoryCut(v);
+      if(!lemma.isNull()){
+        return lemma;
+      }
+    }
+  }
+  return Node::null();
+}
+
+Node TheoryArithPrivate::gomoryCut(ArithVar x_b){
+  const DeltaRational& beta = d_partialModel.getAssignment(x_b);
+  if(!beta.infinitesimalIsZero()){
+    return Node::null();
+  }
+  // f0 is in (0, 1) as the assignment to x_b is not integral
+  Rational f0 = beta.getNoninfinitesimalPart().floor_frac();
+  Rational oneMinusF0 = Rational(1) - f0;
+
+  // The row is x_b = sum a_j x_j. Every x_j sits at a bound, so y_j is either
+  // x_j - l_j or u_j - x_j, y_j >= 0 and x_b + sum abar_j y_j = beta.
+  // The cut is sum c_j y_j >= 1 (Gomory's mixed integer cut).
+  NodeBuilder<> sum(kind::PLUS);
+  Rational rhs(1);
+  ConstraintCPVec bounds;
+  for(Tableau::RowIterator i = d_tableau.basicRowIterator(x_b); !i.atEnd(); ++i){
+    const Tableau::Entry& entry = *i;
+    ArithVar x_j = entry.getColVar();
+    if(x_j == x_b){ continue; }
+
+    bool atLower = d_partialModel.cmpAssignmentLowerBound(x_j) == 0;
+    if(!atLower && d_partialModel.cmpAssignmentUpperBound(x_j) != 0){
+      return Node::null();
+    }
+    ConstraintP c = atLower ? d_partialModel.getLowerBoundConstraint(x_j)
+      : d_partialModel.getUpperBoundConstraint(x_j);
+    const DeltaRational& bound = c->getValue();
+    if(!bound.infinitesimalIsZero()){
+      return Node::null();
+    }
+    Rational a = atLower ? -entry.getCoefficient() : entry.getCoefficient();
+
+    Rational coeff;
+    if(isInteger(x_j) && bound.getNoninfinitesimalPart().isIntegral()){
+      Rational f = a.floor_frac();
+      coeff = (f <= f0) ? f / f0 : (Rational(1) - f) / oneMinusF0;
+    }else{
+      coeff = (a.sgn() >= 0) ? a / f0 : -a / oneMinusF0;
+    }
+    if(coeff.isZero()){
+      continue;
+    }
+    bounds.push_back(c);
+
+    // c_j y_j is c_j x_j - c_j l_j or c_j u_j - c_j x_j
+    const Rational& b = bound.getNoninfinitesimalPart();
+    Rational xCoeff = atLower ? coeff : -coeff;
+    rhs += xCoeff * b;
+    sum << NodeManager::currentNM()->mkNode(
+        kind::MULT, mkRationalNode(xCoeff), d_partialModel.asNode(x_j));
+  }
+
+  Node cut = Rewriter::rewrite(NodeManager::currentNM()->mkNode(
+      kind::GEQ, safeConstructNary(sum), mkRationalNode(rhs)));
+  if(isSatLiteral(cut)){
+    // Already known, the SAT solver has to sort it out
+    return Node::null();
+  }
+  Node premise = Constraint::externalExplainByAssertions(bounds);
+  Node lemma = NodeManager::currentNM()->mkNode(kind::OR, premise.negate(), cut);
+  Debug("arith::gomory") << "gomory cut for " << x_b << ": " << lemma << endl;
+  return lemma;
+}
+
 Node TheoryArithPrivate::callDioSolver(){
   while(!d_constantIntegerVariables.empty()){
     ArithVar v = d_constantIntegerVariables.front();
@@ -3304,30 +3471,34 @@ bool TheoryArithPrivate::solveRealRelaxation(Theory::Effort effortLevel){
   SimplexDecisionProcedure& simplex = selectSimplex(true);
 
   bool useApprox = options::useApprox() && ApproximateSimplex::enabled() && getSolveIntegerResource();
+  // Without glpk the built-in floating point simplex can guess the basis
+  bool useFloat = !useApprox && options::floatRelaxation();
 
   Debug("TheoryArithPrivate::solveRealRelaxation")
     << "solveRealRelaxation() approx"
     << " " <<  options::useApprox()
     << " " << ApproximateSimplex::enabled()
     << " " << useApprox
+    << " " << useFloat
     << " " << safeToCallApprox()
     << endl;
   
-  bool noPivotLimitPass1 = noPivotLimit && !useApprox;
+  bool noPivotLimitPass1 = noPivotLimit && !useApprox && !useFloat;
   d_qflraStatus = simplex.findModel(noPivotLimitPass1);
 
   Debug("TheoryArithPrivate::solveRealRelaxation")
     << "solveRealRelaxation()" << " pass1 " << d_qflraStatus << endl;
   
-  if(d_qflraStatus == Result::SAT_UNKNOWN && useApprox && safeToCallApprox()){
+  if(d_qflraStatus == Result::SAT_UNKNOWN && (useApprox || useFloat) && safeToCallApprox()){
     // pass2: fancy-final
     static const int32_t relaxationLimit = 10000;
-    Assert(ApproximateSimplex::enabled());
+    Assert(useFloat || ApproximateSimplex::enabled());
 
     TreeLog& tl = getTreeLog();
     ApproximateStatistics& stats = getApproxStats();
-    ApproximateSimplex* approxSolver =
-      ApproximateSimplex::mkApproximateSimplexSolver(d_partialModel, tl, stats);
+    ApproximateSimplex* approxSolver = useFloat
+      ? ApproximateSimplex::mkFloatSimplexSolver(d_partialModel, tl, stats)
+      : ApproximateSimplex::mkApproximateSimplexSolver(d_partialModel, tl, stats);
 
     approxSolver->setPivotLimit(relaxationLimit);
 
@@ -3573,6 +3744,7 @@ void TheoryArithPrivate::check(Theory::Effort effortLevel){
   if(newFacts){
     d_qflraStatus = Result::SAT_UNKNOWN;
     d_hasDoneWorkSinceCut = true;
+    d_cubeTestDue = true;
   }
 
   while(!done()){
@@ -3597,6 +3769,14 @@ void TheoryArithPrivate::check(Theory::Effort effortLevel){
     }
   }
 
+  if(!anyConflict() && options::arithIcp() && d_icp.hasMonomials()
+     && !d_updatedBounds.empty()){
+    ConstraintP icpConflict = d_icp.propagate(d_updatedBounds);
+    if(icpConflict != NullConstraint){
+      raiseConflict(icpConflict);
+    }
+  }
+
   if(anyConflict()){
     d_qflraStatus = Result::UNSAT;
     if(options::revertArithModels() && previous == Result::SAT){
@@ -3816,6 +3996,11 @@ void TheoryArithPrivate::check(Theory::Effort effortLevel){
        << " fulleffort " << Theory::fullEffort(effortLevel)
        << " hasintmodel " << hasIntegerModel() << endl;
 
+  if(!emmittedConflictOrSplit && Theory::fullEffort(effortLevel) &&
+     options::arithCubeTest() && !hasIntegerModel()){
+    attemptCubeTest();
+  }
+
   if(!emmittedConflictOrSplit && Theory::fullEffort(effortLevel) && !hasIntegerModel()){
     Node possibleConflict = Node::null();
     if(!emmittedConflictOrSplit && options::arithDioSolver()){
@@ -3842,11 +4027,28 @@ void TheoryArithPrivate::check(Theory::Effort effortLevel){
       }
     }
 
+    // Cuts alone may never give an integer model: they alternate with
+    // branches and stop at the cut limit of the context
+    if(!emmittedConflictOrSplit && options::arithGomoryCuts()
+       && d_qflraStatus == Result::SAT && d_branchSinceGomoryCut
+       && d_cutCount < options::maxCutsInContext()){
+      Node possibleLemma = gomoryCutting();
+      if(!possibleLemma.isNull()){
+        ++(d_statistics.d_gomoryCuts);
+        d_cutCount = d_cutCount + 1;
+        d_branchSinceGomoryCut = false;
+        emmittedConflictOrSplit = true;
+        Debug("arith::lemma") << "gomory cut " << possibleLemma << endl;
+        outputLemma(possibleLemma);
+      }
+    }
+
     if(!emmittedConflictOrSplit) {
       Node possibleLemma = roundRobinBranch();
       if(!possibleLemma.isNull()){
         ++(d_statistics.d_externalBranchAndBounds);
         d_cutCount = d_cutCount + 1;
+        d_branchSinceGomoryCut = true;
         emmittedConflictOrSplit = true;
         Debug("arith::lemma") << "rrbranch lemma"
                               << possibleLemma << endl;
@@ -4654,6 +4856,10 @@ void TheoryArithPrivate::propagateCandidatesNew(){
    *    (This is O(log n) to compute.)
    * 4: The implied bound on x is strictly smaller/greater than the current bound.
    *    (This is O(n) to compute.)
+   *
+   * Rows are only scheduled if they meet 0 and 1, so rows whose bound counts
+   * rule out a propagation are never visited. The rows visited are bounded by
+   * options::arithPropBudget().
    */
 
   TimerStat::CodeTimer codeTimer(d_statistics.d_boundComputationTime);
@@ -4661,17 +4867,25 @@ void TheoryArithPrivate::propagateCandidatesNew(){
 
   Assert(d_qflraStatus == Result::SAT);
   if(d_updatedBounds.empty()){ return; }
+
+  // The bound counts have to be up to date to filter on criterion 1.
+  UpdateTrackingCallback utcb(&d_linEq);
+  d_partialModel.processBoundsQueue(utcb);
+
   dumpUpdatedBoundsToRows();
   Assert(d_updatedBounds.empty());
 
-  if(!d_candidateRows.empty()){
-    UpdateTrackingCallback utcb(&d_linEq);
-    d_partialModel.processBoundsQueue(utcb);
-  }
-
+  const unsigned budget = options::arithPropBudget();
+  unsigned work = 0;
   while(!d_candidateRows.empty()){
+    if(budget > 0 && work >= budget){
+      d_statistics.d_boundRowsDropped += d_candidateRows.size();
+      d_candidateRows.purge();
+      break;
+    }
     RowIndex candidate = d_candidateRows.back();
     d_candidateRows.pop_back();
+    work += d_tableau.getRowLength(candidate);
     propagateCandidateRow(candidate);
   }
   Debug("arith::prop") << "propagateCandidatesNew end" << endl << endl << endl;
@@ -4923,6 +5137,23 @@ bool TheoryArithPrivate::propagateCandidateRow(RowIndex ridx){
   return success;
 }
 
+bool TheoryArithPrivate::rowMightPropagate(RowIndex ridx) const{
+  BoundCounts hasCount = d_linEq.hasBoundCount(ridx);
+  uint32_t rowLength = d_tableau.getRowLength(ridx);
+  return hasCount.lowerBoundCount() + 1 >= rowLength ||
+    hasCount.upperBoundCount() + 1 >= rowLength;
+}
+
+void TheoryArithPrivate::scheduleCandidateRow(RowIndex ridx){
+  if(d_candidateRows.isMember(ridx)){ return; }
+  if(rowMightPropagate(ridx)){
+    d_candidateRows.add(ridx);
+    ++d_statistics.d_boundRowsScheduled;
+  }else{
+    ++d_statistics.d_boundRowsFiltered;
+  }
+}
+
 void TheoryArithPrivate::dumpUpdatedBoundsToRows(){
   Assert(d_candidateRows.empty());
   DenseSet::const_iterator i = d_updatedBounds.begin();
@@ -4931,13 +5162,13 @@ void TheoryArithPrivate::dumpUpdatedBoundsToRows(){
     ArithVar var = *i;
     if(d_tableau.isBasic(var)){
       RowIndex ridx = d_tableau.basicToRowIndex(var);
-      d_candidateRows.softAdd(ridx);
+      scheduleCandidateRow(ridx);
     }else{
       Tableau::ColIterator basicIter = d_tableau.colIterator(var);
       for(; !basicIter.atEnd(); ++basicIter){
         const Tableau::Entry& entry = *basicIter;
         RowIndex ridx = entry.getRowIndex();
-        d_candidateRows.softAdd(ridx);
+        scheduleCandidateRow(ridx);
       }
     }
   }
@@ -5302,7 +5533,14 @@ std::pair<bool, Node> TheoryArithPrivate::entailmentCheck(TNode lit, const Arith
       }
       break;
     case inferbounds::Simplex:
-      {
+      if(options::arithInferBoundsIncremental()){
+        // the row of dp in the tableau stands in for the simplex search
+        entailmentCheckTableauRow(tmp, primDir * dm.sgn(), dp);
+        setToMin(primDir * dm.sgn(), bestPrimDiff, tmp);
+
+        entailmentCheckTableauRow(tmp, secDir * dm.sgn(), dp);
+        setToMin(secDir * dm.sgn(), bestSecDiff, tmp);
+      }else{
         // primDir * diffm * diff < c or primDir * diffm * diff > c
         tmp = entailmentCheckSimplex(primDir * dm.sgn(), dp, ibalg, out.getSimplexSideEffects());
         setToMin(primDir * dm.sgn(), bestPrimDiff, tmp);
@@ -5639,6 +5877,41 @@ void TheoryArithPrivate::entailmentCheckRowSum(std::pair<Node, DeltaRational>& t
   tmp.first = nb;
 }
 
+void TheoryArithPrivate::entailmentCheckTableauRow(std::pair<Node, DeltaRational>& tmp, int sgn, TNode tp) {
+  tmp.first = Node::null();
+  if(sgn == 0){ return; }
+  if(!d_partialModel.hasArithVar(tp)){ return; }
+
+  ArithVar basic = d_partialModel.asArithVar(tp);
+  if(!d_tableau.isBasic(basic)){ return; }
+
+  // basic = \sum c_i * x_i is bounded above if each x_i with c_i > 0 has
+  // an upper bound and each x_i with c_i < 0 has a lower bound
+  bool upperBound = (sgn > 0);
+  RowIndex ridx = d_tableau.basicToRowIndex(basic);
+  if(d_linEq.rowLacksBound(ridx, upperBound, basic) != NULL){ return; }
+
+  NodeBuilder<> nb(kind::AND);
+  for(Tableau::RowIterator i = d_tableau.ridRowIterator(ridx); !i.atEnd(); ++i){
+    const Tableau::Entry& e = *i;
+    ArithVar v = e.getColVar();
+    if(v == basic){ continue; }
+    bool vUb = (upperBound == (e.getCoefficient().sgn() > 0));
+    ConstraintP c = vUb
+      ? d_partialModel.getUpperBoundConstraint(v)
+      : d_partialModel.getLowerBoundConstraint(v);
+    Assert(c != NullConstraint);
+    c->externalExplainByAssertions(nb);
+  }
+  tmp.second = d_linEq.computeRowBound(ridx, upperBound, basic);
+  switch(nb.getNumChildren()){
+  case 0: tmp.first = mkBoolNode(true); break;
+  case 1: tmp.first = nb[0]; break;
+  default: tmp.first = nb; break;
+  }
+  ++d_statistics.d_boundTableauInferences;
+}
+
 std::pair<Node, DeltaRational> TheoryArithPrivate::entailmentCheckSimplex(int sgn, TNode tp, const inferbounds::InferBoundAlgorithm& param, InferBoundsResult& result){
 
   if((sgn == 0) || !(d_qflraStatus == Result::SAT && d_errorSet.noSignals()) || tp.getKind() == CONST_RATIONAL){
@@ -43,12 +43,14 @@
 #include "theory/arith/congruence_manager.h"
 #include "theory/arith/constraint.h"
 #include "theory/arith/constraint.h"
+#include "theory/arith/cube_test.h"
 #include "theory/arith/delta_rational.h"
 #include "theory/arith/delta_rational.h"
 #include "theory/arith/dio_solver.h"
 #include "theory/arith/dual_simplex.h"
 #include "theory/arith/fc_simplex.h"
 #include "theory/arith/infer_bounds.h"
+#include "theory/arith/interval_propagator.h"
 #include "theory/arith/linear_equality.h"
 #include "theory/arith/matrix.h"
 #include "theory/arith/matrix.h"
@@ -126,6 +128,12 @@ private:
    */
   bool d_hasDoneWorkSinceCut;
 
+  /**
+   * True if the last integer lemma was a Gomory cut. Cuts and branches then
+   * alternate, so that branching keeps the search terminating.
+   */
+  bool d_branchSinceGomoryCut;
+
   /** Static learner. */
   ArithStaticLearner d_learner;
 
@@ -139,6 +147,12 @@ private:
   // t does not contain constants
   void entailmentCheckBoundLookup(std::pair<Node, DeltaRational>& tmp, int sgn, TNode tp) const;
   void entailmentCheckRowSum(std::pair<Node, DeltaRational>& tmp, int sgn, TNode tp) const;
+  /**
+   * Bounds tp by its row in the current tableau, if tp is a basic variable.
+   * This is the bound the row propagation would infer, without the
+   * temporary row and the pivots of entailmentCheckSimplex().
+   */
+  void entailmentCheckTableauRow(std::pair<Node, DeltaRational>& tmp, int sgn, TNode tp);
 
   std::pair<Node, DeltaRational> entailmentCheckSimplex(int sgn, TNode tp, const inferbounds::InferBoundAlgorithm& p, InferBoundsResult& out);
 
@@ -239,6 +253,22 @@ private:
   Node callDioSolver();
   Node dioCutting();
 
+  /**
+   * Looks for a basic integer variable with a non-integral assignment whose
+   * row yields a Gomory cut, see gomoryCut().
+   * Returns Node::null() if there is none.
+   */
+  Node gomoryCutting();
+
+  /**
+   * Returns a lemma (=> B cut) where cut is the Gomory mixed integer cut of
+   * the row of the basic variable x_b and B are the bounds of the nonbasic
+   * variables it depends on. The current assignment violates cut.
+   * Requires every nonbasic variable in the row to be at one of its bounds,
+   * and returns Node::null() otherwise.
+   */
+  Node gomoryCut(ArithVar x_b);
+
   Comparison mkIntegerEqualityFromAssignment(ArithVar v);
 
   /**
@@ -291,6 +321,13 @@ private:
    */
   DioSolver d_diosolver;
 
+  /**
+   * The speculative equalities of the last dioCutting() call that found no
+   * cut, and the input constraints of d_diosolver at the time.
+   */
+  std::vector<std::pair<ArithVar, Integer> > d_lastFailedDioCut;
+  std::pair<uint64_t, size_t> d_lastFailedDioCutKey;
+
   /** Counts the number of notifyRestart() calls to the theory. */
   uint32_t d_restartsCounter;
 
@@ -373,6 +410,20 @@ private:
   FCSimplexDecisionProcedure d_fcSimplex;
   SumOfInfeasibilitiesSPD d_soiSimplex;
   AttemptSolutionSDP d_attemptSolSimplex;
+
+  /** Looks for integer models with the unit cube test. */
+  CubeTest d_cubeTest;
+  /** Has anything been asserted since the last failed cube test? */
+  bool d_cubeTestDue;
+
+  /**
+   * Runs the cube test if it is due, and installs the integer model it
+   * finds.
+   */
+  void attemptCubeTest();
+
+  /** Propagates bounds through the non-linear monomials. */
+  IntervalPropagator d_icp;
   
   /** non-linear algebraic approach */
   NonlinearExtension * d_nonlinearExtension;
@@ -575,6 +626,14 @@ private:
 
   void propagateCandidatesNew();
   void dumpUpdatedBoundsToRows();
+  /**
+   * Can the bound counts of the row allow a propagation? This requires all of
+   * the variables, or all but one, to have the lower or the upper bounds the
+   * row needs.
+   */
+  bool rowMightPropagate(RowIndex ridx) const;
+  /** Adds ridx to d_candidateRows if rowMightPropagate(ridx). */
+  void scheduleCandidateRow(RowIndex ridx);
   bool propagateCandidateRow(RowIndex rid);
   bool propagateMightSucceed(ArithVar v, bool ub) const;
   /** Attempt to perform a row propagation where there is at most 1 possible variable.*/
@@ -741,6 +800,8 @@ private:
     TimerStat d_newPropTime;
 
     IntStat d_externalBranchAndBounds;
+    IntStat d_gomoryCuts;
+    IntStat d_dioCutsSkipped;
 
     IntStat d_initialTableauSize;
     IntStat d_currSetToSmaller;
@@ -749,6 +810,8 @@ private:
 
     TimerStat d_boundComputationTime;
     IntStat d_boundComputations, d_boundPropagations;
+    IntStat d_boundRowsScheduled, d_boundRowsFiltered, d_boundRowsDropped;
+    IntStat d_boundTableauInferences;
 
     IntStat d_unknownChecks;
     IntStat d_maxUnknownsInARow;
@@ -0,0 +1,501 @@
+/*********************                                                        */
+/*! \file univariate_covering.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A complete decision procedure for univariate polynomial constraints.
+ **
+ ** Implementation of the univariate covering.
+ **/
+
+#include "theory/arith/univariate_covering.h"
+
+#include <algorithm>
+
+#include "base/cvc4_assert.h"
+#include "base/output.h"
+
+using namespace CVC4::kind;
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+namespace {
+
+void trim(UPoly& p)
+{
+  while (!p.empty() && p.back().isZero())
+  {
+    p.pop_back();
+  }
+}
+
+Rational evaluate(const UPoly& p, const Rational& x)
+{
+  Rational res(0);
+  for (size_t i = p.size(); i > 0; --i)
+  {
+    res = res * x + p[i - 1];
+  }
+  return res;
+}
+
+UPoly add(const UPoly& a, const UPoly& b)
+{
+  UPoly res(std::max(a.size(), b.size()), Rational(0));
+  for (size_t i = 0; i < a.size(); ++i)
+  {
+    res[i] += a[i];
+  }
+  for (size_t i = 0; i < b.size(); ++i)
+  {
+    res[i] += b[i];
+  }
+  trim(res);
+  return res;
+}
+
+UPoly negate(const UPoly& p)
+{
+  UPoly res(p);
+  for (Rational& c : res)
+  {
+    c = -c;
+  }
+  return res;
+}
+
+UPoly multiply(const UPoly& a, const UPoly& b)
+{
+  if (a.empty() || b.empty())
+  {
+    return UPoly();
+  }
+  UPoly res(a.size() + b.size() - 1, Rational(0));
+  for (size_t i = 0; i < a.size(); ++i)
+  {
+    for (size_t j = 0; j < b.size(); ++j)
+    {
+      res[i + j] += a[i] * b[j];
+    }
+  }
+  return res;
+}
+
+UPoly derivative(const UPoly& p)
+{
+  UPoly res;
+  for (size_t i = 1; i < p.size(); ++i)
+  {
+    res.push_back(p[i] * Rational(i));
+  }
+  return res;
+}
+
+/** The remainder of the division of a by the non-zero b. */
+UPoly remainder(const UPoly& a, const UPoly& b)
+{
+  Assert(!b.empty());
+  UPoly r(a);
+  while (r.size() >= b.size())
+  {
+    Rational c = r.back() / b.back();
+    size_t shift = r.size() - b.size();
+    for (size_t i = 0; i < b.size(); ++i)
+    {
+      r[i + shift] -= c * b[i];
+    }
+    r.pop_back();
+    trim(r);
+  }
+  return r;
+}
+
+UPoly gcd(UPoly a, UPoly b)
+{
+  while (!b.empty())
+  {
+    UPoly r = remainder(a, b);
+    a.swap(b);
+    b.swap(r);
+  }
+  return a;
+}
+
+/** The Sturm sequence p, p', -rem(p, p'), ... of the non-constant p. */
+std::vector<UPoly> sturmSequence(const UPoly& p)
+{
+  std::vector<UPoly> seq;
+  seq.push_back(p);
+  seq.push_back(derivative(p));
+  while (seq.back().size() > 1)
+  {
+    UPoly r = negate(remainder(seq[seq.size() - 2], seq.back()));
+    if (r.empty())
+    {
+      break;
+    }
+    seq.push_back(r);
+  }
+  return seq;
+}
+
+unsigned signVariations(const std::vector<UPoly>& seq, const Rational& x)
+{
+  unsigned res = 0;
+  int last = 0;
+  for (const UPoly& p : seq)
+  {
+    int s = evaluate(p, x).sgn();
+    if (s != 0)
+    {
+      if (last != 0 && s != last)
+      {
+        res++;
+      }
+      last = s;
+    }
+  }
+  return res;
+}
+
+/**
+ * The number of distinct roots in (lo, hi) of the first polynomial of the
+ * Sturm sequence seq, where lo < hi are not roots.
+ */
+unsigned countRoots(const std::vector<UPoly>& seq,
+                    const Rational& lo,
+                    const Rational& hi)
+{
+  return signVariations(seq, lo) - signVariations(seq, hi);
+}
+
+/** A bound on the absolute value of the roots of the non-constant p. */
+Rational rootBound(const UPoly& p)
+{
+  Rational res(0);
+  for (size_t i = 0; i + 1 < p.size(); ++i)
+  {
+    Rational c = (p[i] / p.back()).abs();
+    if (c > res)
+    {
+      res = c;
+    }
+  }
+  return res + Rational(1);
+}
+
+}  // namespace
+
+void UnivariateCovering::addConstraint(const UPoly& p, unsigned signs)
+{
+  UPoly q(p);
+  trim(q);
+  d_polys.push_back(q);
+  d_signs.push_back(signs);
+}
+
+unsigned UnivariateCovering::firstViolated(const std::vector<int>& signs) const
+{
+  for (unsigned i = 0; i < d_polys.size(); ++i)
+  {
+    unsigned s = signs[i] < 0 ? SIGN_NEG : (signs[i] == 0 ? SIGN_ZERO : SIGN_POS);
+    if ((d_signs[i] & s) == 0)
+    {
+      return i;
+    }
+  }
+  return d_polys.size();
+}
+
+void UnivariateCovering::isolateRoots()
+{
+  d_roots.clear();
+  d_productSturm.clear();
+  if (d_product.size() < 2)
+  {
+    return;
+  }
+  d_productSturm = sturmSequence(d_product);
+  Rational bound = rootBound(d_product);
+  isolate(-bound, bound);
+}
+
+void UnivariateCovering::isolate(const Rational& lo, const Rational& hi)
+{
+  unsigned n = countRoots(d_productSturm, lo, hi);
+  if (n == 0)
+  {
+    return;
+  }
+  if (n == 1)
+  {
+    Root r;
+    r.d_lo = lo;
+    r.d_hi = hi;
+    d_roots.push_back(r);
+    return;
+  }
+  // split at a point that is not a root, a root at the middle is found in
+  // the right half
+  Rational mid = (lo + hi) / Rational(2);
+  while (evaluate(d_product, mid).isZero())
+  {
+    mid = (lo + mid) / Rational(2);
+  }
+  isolate(lo, mid);
+  isolate(mid, hi);
+}
+
+void UnivariateCovering::refine(Root& r) const
+{
+  Assert(!r.isExact());
+  Rational mid = (r.d_lo + r.d_hi) / Rational(2);
+  if (evaluate(d_product, mid).isZero())
+  {
+    r.d_lo = mid;
+    r.d_hi = mid;
+  }
+  else if (countRoots(d_productSturm, r.d_lo, mid) == 1)
+  {
+    r.d_hi = mid;
+  }
+  else
+  {
+    r.d_lo = mid;
+  }
+}
+
+int UnivariateCovering::signAtRoot(const UPoly& p, Root& r) const
+{
+  if (r.isExact() || p.size() < 2)
+  {
+    return evaluate(p, r.d_lo).sgn();
+  }
+  // r is the only root of the product in (lo, hi), p vanishes at r iff the
+  // common factor of p and the product has a root in there
+  UPoly g = gcd(p, d_product);
+  if (g.size() >= 2 && countRoots(sturmSequence(g), r.d_lo, r.d_hi) > 0)
+  {
+    return 0;
+  }
+  // shrink the interval until it has no root of p, every root of p is a root
+  // of the product so lo and hi are never roots of p
+  std::vector<UPoly> seq = sturmSequence(p);
+  while (countRoots(seq, r.d_lo, r.d_hi) > 0)
+  {
+    refine(r);
+    if (r.isExact())
+    {
+      return evaluate(p, r.d_lo).sgn();
+    }
+  }
+  return evaluate(p, r.d_lo).sgn();
+}
+
+void UnivariateCovering::findRationalRoot(const UPoly& p, Root& r) const
+{
+  // with integer coefficients and the leading coefficient l, every rational
+  // root is n/l for some integer n, which is the nearest one once the
+  // interval is shorter than 1/(2l)
+  Integer den(1);
+  for (const Rational& c : p)
+  {
+    den = den.lcm(c.getDenominator());
+  }
+  Rational l = (p.back() * Rational(den)).abs();
+  while (!r.isExact() && (r.d_hi - r.d_lo) * l * Rational(2) >= Rational(1))
+  {
+    refine(r);
+  }
+  if (r.isExact())
+  {
+    return;
+  }
+  Rational mid = (r.d_lo + r.d_hi) / Rational(2);
+  Rational c = Rational((mid * l + Rational(1, 2)).floor()) / l;
+  if (r.d_lo < c && c < r.d_hi && evaluate(p, c).isZero())
+  {
+    r.d_lo = c;
+    r.d_hi = c;
+  }
+}
+
+UnivariateCovering::Result UnivariateCovering::check()
+{
+  d_covering.clear();
+  d_product = UPoly(1, Rational(1));
+  for (const UPoly& p : d_polys)
+  {
+    if (p.size() >= 2)
+    {
+      d_product = multiply(d_product, p);
+    }
+  }
+  isolateRoots();
+  Trace("nl-cover") << "UnivariateCovering: " << d_polys.size()
+                    << " constraints, " << d_roots.size() << " roots"
+                    << std::endl;
+
+  std::vector<unsigned> violated;
+  std::vector<int> signs(d_polys.size());
+  // the open cells first, they always have a rational sample: the bounds of
+  // the isolating intervals are not roots
+  for (size_t i = 0; i <= d_roots.size(); ++i)
+  {
+    Rational sample;
+    if (d_roots.empty())
+    {
+      sample = Rational(0);
+    }
+    else if (i == 0)
+    {
+      sample = d_roots[0].d_lo - Rational(1);
+    }
+    else if (i == d_roots.size())
+    {
+      sample = d_roots[i - 1].d_hi + Rational(1);
+    }
+    else
+    {
+      sample = (d_roots[i - 1].d_hi + d_roots[i].d_lo) / Rational(2);
+    }
+    for (unsigned j = 0; j < d_polys.size(); ++j)
+    {
+      signs[j] = evaluate(d_polys[j], sample).sgn();
+    }
+    unsigned v = firstViolated(signs);
+    if (v == d_polys.size())
+    {
+      Trace("nl-cover") << "...satisfied at " << sample << std::endl;
+      d_sample = sample;
+      return SAMPLE;
+    }
+    violated.push_back(v);
+  }
+  bool irrational = false;
+  for (Root& r : d_roots)
+  {
+    for (unsigned j = 0; j < d_polys.size(); ++j)
+    {
+      signs[j] = signAtRoot(d_polys[j], r);
+    }
+    unsigned v = firstViolated(signs);
+    if (v == d_polys.size())
+    {
+      if (!r.isExact())
+      {
+        // some factor of the product vanishes at each of its roots
+        for (unsigned j = 0; j < d_polys.size(); ++j)
+        {
+          if (signs[j] == 0 && d_polys[j].size() >= 2)
+          {
+            findRationalRoot(d_polys[j], r);
+            break;
+          }
+        }
+      }
+      if (r.isExact())
+      {
+        Trace("nl-cover") << "...satisfied at the root " << r.d_lo
+                          << std::endl;
+        d_sample = r.d_lo;
+        return SAMPLE;
+      }
+      Trace("nl-cover") << "...satisfied at the root in (" << r.d_lo << ", "
+                        << r.d_hi << ")" << std::endl;
+      irrational = true;
+    }
+    else
+    {
+      violated.push_back(v);
+    }
+  }
+  if (irrational)
+  {
+    return NO_RATIONAL_SAMPLE;
+  }
+  std::sort(violated.begin(), violated.end());
+  violated.erase(std::unique(violated.begin(), violated.end()),
+                 violated.end());
+  d_covering = violated;
+  Trace("nl-cover") << "...covered by " << d_covering.size()
+                    << " constraints" << std::endl;
+  return COVERED;
+}
+
+bool UnivariateCovering::mkPolynomial(TNode n, Node& x, UPoly& p)
+{
+  p.clear();
+  switch (n.getKind())
+  {
+    case CONST_RATIONAL:
+      p.push_back(n.getConst<Rational>());
+      trim(p);
+      return true;
+    case PLUS:
+    case MINUS:
+    {
+      for (unsigned i = 0; i < n.getNumChildren(); ++i)
+      {
+        UPoly c;
+        if (!mkPolynomial(n[i], x, c))
+        {
+          return false;
+        }
+        p = add(p, (i > 0 && n.getKind() == MINUS) ? negate(c) : c);
+      }
+      return true;
+    }
+    case UMINUS:
+    {
+      UPoly c;
+      if (!mkPolynomial(n[0], x, c))
+      {
+        return false;
+      }
+      p = negate(c);
+      return true;
+    }
+    case MULT:
+    case NONLINEAR_MULT:
+    {
+      p.push_back(Rational(1));
+      for (const Node& nc : n)
+      {
+        UPoly c;
+        if (!mkPolynomial(nc, x, c))
+        {
+          return false;
+        }
+        p = multiply(p, c);
+      }
+      return true;
+    }
+    default: break;
+  }
+  if (!n.isVar() || !n.getType().isReal())
+  {
+    return false;
+  }
+  if (x.isNull())
+  {
+    x = n;
+  }
+  else if (x != n)
+  {
+    return false;
+  }
+  p.push_back(Rational(0));
+  p.push_back(Rational(1));
+  return true;
+}
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
@@ -0,0 +1,131 @@
+/*********************                                                        */
+/*! \file univariate_covering.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A complete decision procedure for univariate polynomial constraints.
+ **
+ ** The real line is decomposed into the cells on which every polynomial has a
+ ** constant sign: the real roots of the polynomials and the open intervals
+ ** between them. The roots are isolated exactly with Sturm sequences. If every
+ ** cell violates some constraint, the violated constraints cover the real
+ ** line and their conjunction is unsatisfiable. This is the one-dimensional
+ ** case of cylindrical algebraic coverings (Abraham et al., "Deciding the
+ ** consistency of non-linear real arithmetic constraints with a conflict
+ ** driven search using cylindrical algebraic coverings", JLAMP 2021).
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__ARITH__UNIVARIATE_COVERING_H
+#define CVC4__THEORY__ARITH__UNIVARIATE_COVERING_H
+
+#include <vector>
+
+#include "expr/node.h"
+#include "util/rational.h"
+
+namespace CVC4 {
+namespace theory {
+namespace arith {
+
+/**
+ * A univariate polynomial with rational coefficients. The i^th entry is the
+ * coefficient of x^i, and the last entry, if any, is non-zero.
+ */
+typedef std::vector<Rational> UPoly;
+
+class UnivariateCovering
+{
+ public:
+  /** The signs a constraint may allow, combined as a bit mask. */
+  enum Sign
+  {
+    SIGN_NEG = 1,
+    SIGN_ZERO = 2,
+    SIGN_POS = 4
+  };
+
+  enum Result
+  {
+    /** The constraints are unsatisfiable, see getCovering(). */
+    COVERED,
+    /** The constraints are satisfied by the rational getSample(). */
+    SAMPLE,
+    /** The constraints are only satisfied at irrational roots. */
+    NO_RATIONAL_SAMPLE
+  };
+
+  /** Add the constraint that the sign of p is in the mask signs. */
+  void addConstraint(const UPoly& p, unsigned signs);
+
+  /** The number of constraints added so far. */
+  size_t getNumConstraints() const { return d_polys.size(); }
+
+  /** Decide the conjunction of the constraints. */
+  Result check();
+
+  /** The satisfying point, after check() returned SAMPLE. */
+  const Rational& getSample() const { return d_sample; }
+
+  /**
+   * The indices of a subset of the constraints whose conjunction is
+   * unsatisfiable, in increasing order, after check() returned COVERED.
+   */
+  const std::vector<unsigned>& getCovering() const { return d_covering; }
+
+  /**
+   * Convert the arithmetic term n to a polynomial in the variable x. If x is
+   * null, it is set to the first variable found. Returns false if n is not a
+   * polynomial over x alone.
+   */
+  static bool mkPolynomial(TNode n, Node& x, UPoly& p);
+
+ private:
+  /** A real root, either the rational lo == hi or the only one in (lo, hi) */
+  struct Root
+  {
+    Rational d_lo;
+    Rational d_hi;
+    bool isExact() const { return d_lo == d_hi; }
+  };
+
+  /** Put the roots of d_product into d_roots, in increasing order. */
+  void isolateRoots();
+  void isolate(const Rational& lo, const Rational& hi);
+  /** Halve the isolating interval of r. */
+  void refine(Root& r) const;
+  /**
+   * Make r exact if it is rational, p is a polynomial that vanishes at r. The
+   * interval of r may be refined.
+   */
+  void findRationalRoot(const UPoly& p, Root& r) const;
+  /** The sign of the polynomial at the root r, which may be refined. */
+  int signAtRoot(const UPoly& p, Root& r) const;
+  /**
+   * The index of the first constraint violated by the signs, or
+   * getNumConstraints() if none is.
+   */
+  unsigned firstViolated(const std::vector<int>& signs) const;
+
+  std::vector<UPoly> d_polys;
+  std::vector<unsigned> d_signs;
+
+  /** The product of the non-constant polynomials and its Sturm sequence. */
+  UPoly d_product;
+  std::vector<UPoly> d_productSturm;
+  std::vector<Root> d_roots;
+
+  Rational d_sample;
+  std::vector<unsigned> d_covering;
+}; /* class UnivariateCovering */
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__ARITH__UNIVARIATE_COVERING_H */
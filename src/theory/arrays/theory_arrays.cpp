@@ -23,6 +23,7 @@
 #include "expr/node_algorithm.h"
 #include "options/arrays_options.h"
 #include "options/smt_options.h"
+#include "options/theory_options.h"
 #include "proof/array_proof.h"
 #include "proof/proof_manager.h"
 #include "proof/theory_proof.h"
@@ -87,7 +88,8 @@ TheoryArrays::TheoryArrays(context::Context* c,
       d_isPreRegistered(c),
       d_mayEqualEqualityEngine(c, name + "theory::arrays::mayEqual", true),
       d_notify(*this),
-      d_equalityEngine(d_notify, c, name + "theory::arrays", true),
+      d_ownEqualityEngine(),
+      d_equalityEngine(initEqualityEngine(c, name)),
       d_conflict(c, false),
       d_backtracker(c),
       d_infoMap(c, &d_backtracker, name),
@@ -177,8 +179,29 @@ TheoryArrays::~TheoryArrays() {
   smtStatisticsRegistry()->unregisterStat(&d_numSetModelValConflicts);
 }
 
+eq::EqualityEngine& TheoryArrays::initEqualityEngine(context::Context* c,
+                                                    std::string name)
+{
+  eq::EqualityEngine* ee = nullptr;
+  if (options::eeCentral())
+  {
+    ee = d_valuation.getCentralEqualityEngine(THEORY_ARRAYS, &d_notify);
+  }
+  if (ee == nullptr)
+  {
+    d_ownEqualityEngine.reset(
+        new eq::EqualityEngine(d_notify, c, name + "theory::arrays", true));
+    ee = d_ownEqualityEngine.get();
+  }
+  return *ee;
+}
+
 void TheoryArrays::setMasterEqualityEngine(eq::EqualityEngine* eq) {
-  d_equalityEngine.setMasterEqualityEngine(eq);
+  // The central equality engine is connected by the theory engine
+  if (d_ownEqualityEngine)
+  {
+    d_equalityEngine.setMasterEqualityEngine(eq);
+  }
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -19,6 +19,7 @@
 #ifndef CVC4__THEORY__ARRAYS__THEORY_ARRAYS_H
 #define CVC4__THEORY__ARRAYS__THEORY_ARRAYS_H
 
+#include <memory>
 #include <tuple>
 #include <unordered_map>
 
@@ -343,8 +344,14 @@ class TheoryArrays : public Theory {
   /** The notify class for d_equalityEngine */
   NotifyClass d_notify;
 
+  /** Equality engine of this theory, null if the central one is used */
+  std::unique_ptr<eq::EqualityEngine> d_ownEqualityEngine;
+
   /** Equaltity engine */
-  eq::EqualityEngine d_equalityEngine;
+  eq::EqualityEngine& d_equalityEngine;
+
+  /** Get the central equality engine, or make our own */
+  eq::EqualityEngine& initEqualityEngine(context::Context* c, std::string name);
 
   /** Are we in conflict? */
   context::CDO<bool> d_conflict;
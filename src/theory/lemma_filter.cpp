@@ -0,0 +1,85 @@
+/*********************                                                        */
+/*! \file lemma_filter.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Filter for redundant theory lemmas
+ **
+ ** Implementation of the filter for redundant theory lemmas.
+ **/
+
+#include "theory/lemma_filter.h"
+
+#include <algorithm>
+
+#include "base/output.h"
+
+namespace CVC4 {
+namespace theory {
+
+LemmaFilter::LemmaFilter(context::UserContext* u, unsigned window)
+    : d_lemmas(u), d_window(window)
+{
+}
+
+LemmaFilter::Result LemmaFilter::check(TNode lemma, bool record)
+{
+  if (d_lemmas.contains(lemma))
+  {
+    return DUPLICATE;
+  }
+  if (lemma.getKind() == kind::OR)
+  {
+    for (const Node& c : d_recent)
+    {
+      // lemmas of popped user contexts are no longer in the SAT solver
+      if (d_lemmas.contains(c) && subsumes(c, lemma))
+      {
+        Trace("lemma-filter") << "LemmaFilter: " << lemma << " is subsumed by "
+                              << c << std::endl;
+        return SUBSUMED;
+      }
+    }
+  }
+  if (record)
+  {
+    d_lemmas.insert(lemma);
+    if (d_window > 0)
+    {
+      if (d_recent.size() == d_window)
+      {
+        d_recent.pop_back();
+      }
+      d_recent.push_front(lemma);
+    }
+  }
+  return NEW;
+}
+
+bool LemmaFilter::subsumes(TNode c, TNode d)
+{
+  Assert(d.getKind() == kind::OR);
+  if (c.getKind() != kind::OR)
+  {
+    return std::find(d.begin(), d.end(), c) != d.end();
+  }
+  if (c.getNumChildren() > d.getNumChildren())
+  {
+    return false;
+  }
+  for (const Node& lit : c)
+  {
+    if (std::find(d.begin(), d.end(), lit) == d.end())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace theory
+}  // namespace CVC4
@@ -0,0 +1,77 @@
+/*********************                                                        */
+/*! \file lemma_filter.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Filter for redundant theory lemmas
+ **
+ ** Filter for theory lemmas that are already known to the SAT solver, either
+ ** literally or as a subset of their literals.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__LEMMA_FILTER_H
+#define CVC4__THEORY__LEMMA_FILTER_H
+
+#include <deque>
+
+#include "context/cdhashset.h"
+#include "context/context.h"
+#include "expr/node.h"
+
+namespace CVC4 {
+namespace theory {
+
+/**
+ * Remembers the (rewritten) permanent lemmas of the current user context.
+ * A lemma is redundant if it has already been sent, or if it is a clause
+ * that is subsumed by one of the last few lemmas that were sent. Lemmas are
+ * forgotten when the user context they were sent in is popped.
+ */
+class LemmaFilter
+{
+ public:
+  enum Result
+  {
+    /** the lemma is new */
+    NEW,
+    /** the same lemma has already been sent */
+    DUPLICATE,
+    /** a recent lemma is a sub-clause of the lemma */
+    SUBSUMED
+  };
+
+  /**
+   * Create a filter whose lemmas live in context u, subsumption is checked
+   * against the last window lemmas.
+   */
+  LemmaFilter(context::UserContext* u, unsigned window);
+
+  /**
+   * Check whether the rewritten lemma is redundant. If it is new and
+   * record is true, it will be used to filter the later lemmas (record
+   * should be false for lemmas that the SAT solver may delete).
+   */
+  Result check(TNode lemma, bool record);
+
+ private:
+  /** Are the literals of c a subset of the ones of the clause d? */
+  static bool subsumes(TNode c, TNode d);
+
+  /** The lemmas sent in the current user context */
+  context::CDHashSet<Node, NodeHashFunction> d_lemmas;
+  /** The most recent lemmas, most recent first (may have been popped) */
+  std::deque<Node> d_recent;
+  /** Maximal size of d_recent */
+  unsigned d_window;
+}; /* class LemmaFilter */
+
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__LEMMA_FILTER_H */
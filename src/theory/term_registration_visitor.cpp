@@ -22,6 +22,48 @@ using namespace std;
 using namespace CVC4;
 using namespace theory;
 
+namespace {
+
+/**
+ * Is current below parent a term that the visitors don't look at, e.g. a
+ * term below a binder?
+ */
+bool isRegistrationSkipped(TNode current, TNode parent)
+{
+  return (parent.isClosure() || parent.getKind() == kind::REWRITE_RULE
+          || parent.getKind() == kind::SEP_STAR
+          || parent.getKind() == kind::SEP_WAND
+          || (parent.getKind() == kind::SEP_LABEL
+              && current.getType().isBoolean())
+          // parent.getKind() == kind::CARDINALITY_CONSTRAINT
+          )
+         && current != parent;
+}
+
+/**
+ * The theories current is registered with when it occurs below parent: its
+ * own and the one of its parent, and the one of its type if it is enclosed
+ * by another theory or if its type is finite and belongs to another theory.
+ */
+Theory::Set getRegistrationTheories(TNode current, TNode parent)
+{
+  TheoryId currentTheoryId = Theory::theoryOf(current);
+  TheoryId parentTheoryId = Theory::theoryOf(parent);
+  Theory::Set theories = Theory::setInsert(currentTheoryId);
+  theories = Theory::setInsert(parentTheoryId, theories);
+  if (current != parent) {
+    TypeNode type = current.getType();
+    TheoryId typeTheoryId = Theory::theoryOf(type);
+    if (currentTheoryId != parentTheoryId
+        || (typeTheoryId != currentTheoryId && type.isInterpretedFinite())) {
+      theories = Theory::setInsert(typeTheoryId, theories);
+    }
+  }
+  return theories;
+}
+
+}  // namespace
+
 std::string PreRegisterVisitor::toString() const {
   std::stringstream ss;
   TNodeToTheorySetMap::const_iterator it = d_visited.begin();
@@ -35,13 +77,7 @@ bool PreRegisterVisitor::alreadyVisited(TNode current, TNode parent) {
 
   Debug("register::internal") << "PreRegisterVisitor::alreadyVisited(" << current << "," << parent << ")" << std::endl;
 
-  if ((parent.isClosure() || parent.getKind() == kind::REWRITE_RULE
-       || parent.getKind() == kind::SEP_STAR
-       || parent.getKind() == kind::SEP_WAND
-       || (parent.getKind() == kind::SEP_LABEL && current.getType().isBoolean())
-       // parent.getKind() == kind::CARDINALITY_CONSTRAINT
-       )
-      && current != parent)
+  if (isRegistrationSkipped(current, parent))
   {
     Debug("register::internal") << "quantifier:true" << std::endl;
     return true;
@@ -178,17 +214,25 @@ bool SharedTermsVisitor::alreadyVisited(TNode current, TNode parent) const {
 
   Debug("register::internal") << "SharedTermsVisitor::alreadyVisited(" << current << "," << parent << ")" << std::endl;
 
-  if ((parent.isClosure() || parent.getKind() == kind::REWRITE_RULE
-       || parent.getKind() == kind::SEP_STAR
-       || parent.getKind() == kind::SEP_WAND
-       || (parent.getKind() == kind::SEP_LABEL && current.getType().isBoolean())
-       // parent.getKind() == kind::CARDINALITY_CONSTRAINT
-       )
-      && current != parent)
+  if (isRegistrationSkipped(current, parent))
   {
     Debug("register::internal") << "quantifier:true" << std::endl;
     return true;
   }
+
+  Theory::Set theories = getRegistrationTheories(current, parent);
+
+  // A term that only belongs to its own theory, and has no shared terms
+  // below it, adds nothing to the shared terms of any atom, so there is no
+  // need to traverse it again for every atom it occurs in
+  if (current != parent
+      && theories == Theory::setInsert(Theory::theoryOf(current))
+      && isPure(current))
+  {
+    Debug("register::internal") << "pure:true" << std::endl;
+    return true;
+  }
+
   TNodeVisitedMap::const_iterator find = d_visited.find(current);
 
   // If node is not visited at all, just return false
@@ -197,61 +241,52 @@ bool SharedTermsVisitor::alreadyVisited(TNode current, TNode parent) const {
     return false;
   }
 
-  Theory::Set theories = (*find).second;
-
-  TheoryId currentTheoryId = Theory::theoryOf(current);
-  TheoryId parentTheoryId  = Theory::theoryOf(parent);
-
-  // Should we use the theory of the type
-  bool useType = false;
-  TheoryId typeTheoryId = THEORY_LAST;
+  return Theory::setDifference(theories, (*find).second) == 0;
+}
 
-  if (current != parent) {
-    if (currentTheoryId != parentTheoryId) {
-      // If enclosed by different theories it's shared -- in read(a, f(a)) f(a) should be shared with integers
-      TypeNode type = current.getType();
-      useType = true;
-      typeTheoryId = Theory::theoryOf(type);
-    } else {
-      TypeNode type = current.getType();
-      typeTheoryId = Theory::theoryOf(type);
-      if (typeTheoryId != currentTheoryId) {
-        if (type.isInterpretedFinite()) {
-          useType = true;
-        }
-      }
+bool SharedTermsVisitor::isPure(TNode n) const
+{
+  std::vector<TNode> toVisit;
+  toVisit.push_back(n);
+  while (!toVisit.empty())
+  {
+    TNode current = toVisit.back();
+    if (d_pure.find(current) != d_pure.end())
+    {
+      toVisit.pop_back();
+      continue;
     }
-  }
-  if (current != parent) {
-    if (currentTheoryId != parentTheoryId) {
-      // If enclosed by different theories it's shared -- in read(a, f(a)) f(a) should be shared with integers
-      TypeNode type = current.getType();
-      useType = true;
-      typeTheoryId = Theory::theoryOf(type);
-    } else {
-      TypeNode type = current.getType();
-      typeTheoryId = Theory::theoryOf(type);
-      if (typeTheoryId != currentTheoryId) {
-        if (type.isInterpretedFinite()) {
-          useType = true;
-        }
+    // compute the children first
+    bool ready = true;
+    for (TNode child : current)
+    {
+      if (!isRegistrationSkipped(child, current)
+          && d_pure.find(child) == d_pure.end())
+      {
+        toVisit.push_back(child);
+        ready = false;
       }
     }
-  }
-
-  if (Theory::setContains(currentTheoryId, theories)) {
-      if (Theory::setContains(parentTheoryId, theories)) {
-        if (useType) {
-          return Theory::setContains(typeTheoryId, theories);
-        } else {
-          return true;
-        }
-      } else {
-        return false;
+    if (!ready)
+    {
+      continue;
+    }
+    toVisit.pop_back();
+    bool pure = true;
+    for (TNode child : current)
+    {
+      if (!isRegistrationSkipped(child, current)
+          && (!d_pure[child]
+              || getRegistrationTheories(child, current)
+                     != Theory::setInsert(Theory::theoryOf(child))))
+      {
+        pure = false;
+        break;
       }
-  } else {
-    return false;
+    }
+    d_pure[current] = pure;
   }
+  return d_pure[n];
 }
 
 void SharedTermsVisitor::visit(TNode current, TNode parent) {
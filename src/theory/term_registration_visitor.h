@@ -108,6 +108,13 @@ class SharedTermsVisitor {
   typedef std::unordered_map<TNode, theory::Theory::Set, TNodeHashFunction> TNodeVisitedMap;
   TNodeVisitedMap d_visited;
 
+  /**
+   * Whether there are no shared terms below each node, see isPure(). This
+   * depends on the options of the engine, so it is kept here rather than in
+   * an attribute of the nodes. It is not cleared with the rest of the state.
+   */
+  mutable std::unordered_map<Node, bool, NodeHashFunction> d_pure;
+
   /**
    * String representation of the visited map, for debugging purposes.
    */
@@ -134,6 +141,13 @@ public:
    * Pre-registeres current with any of the current and parent theories that haven't seen the term yet.
    */
   void visit(TNode current, TNode parent);
+
+  /**
+   * Returns true if there are no shared terms below n, whatever atom n
+   * occurs in. This only depends on the structure of n and on the options,
+   * so it is cached for the lifetime of the visitor.
+   */
+  bool isPure(TNode n) const;
   
   /**
    * Marks the node as the starting literal.
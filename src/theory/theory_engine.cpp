@@ -17,6 +17,7 @@
 #include "theory/theory_engine.h"
 
 #include <list>
+#include <sstream>
 #include <vector>
 
 #include "base/map_util.h"
@@ -26,9 +27,11 @@
 #include "expr/node_algorithm.h"
 #include "expr/node_builder.h"
 #include "options/bv_options.h"
+#include "options/option_exception.h"
 #include "options/options.h"
 #include "options/proof_options.h"
 #include "options/quantifiers_options.h"
+#include "options/theory_options.h"
 #include "preprocessing/assertion_pipeline.h"
 #include "proof/cnf_proof.h"
 #include "proof/lemma_proof.h"
@@ -88,6 +91,13 @@ theory::LemmaStatus TheoryEngine::EngineOutputChannel::lemma(TNode lemma,
   ++d_statistics.lemmas;
   d_engine->d_outputChannelUsed = true;
 
+  Node redundant = filterLemma(lemma, removable);
+  if (!redundant.isNull())
+  {
+    return theory::LemmaStatus(redundant,
+                               d_engine->d_userContext->getLevel());
+  }
+
   PROOF({ registerLemmaRecipe(lemma, lemma, preprocess, d_theory); });
 
   theory::LemmaStatus result =
@@ -96,6 +106,30 @@ theory::LemmaStatus TheoryEngine::EngineOutputChannel::lemma(TNode lemma,
   return result;
 }
 
+Node TheoryEngine::EngineOutputChannel::filterLemma(TNode lemma,
+                                                    bool removable)
+{
+  if (!d_engine->d_lemmaFilter)
+  {
+    return Node::null();
+  }
+  Node rlemma = theory::Rewriter::rewrite(lemma);
+  // lemmas that the SAT solver may delete can be filtered, but must not be
+  // used to filter the later ones
+  switch (d_engine->d_lemmaFilter->check(rlemma, !removable))
+  {
+    case LemmaFilter::NEW: return Node::null();
+    case LemmaFilter::DUPLICATE: ++d_statistics.lemmasDuplicate; break;
+    case LemmaFilter::SUBSUMED: ++d_statistics.lemmasSubsumed; break;
+  }
+  Debug("theory::lemma") << "EngineOutputChannel<" << d_theory
+                         << ">::lemma: " << lemma << " is redundant"
+                         << std::endl;
+  // the theory expects another check round, as with an actual lemma
+  d_engine->d_lemmasAdded = true;
+  return rlemma;
+}
+
 void TheoryEngine::EngineOutputChannel::registerLemmaRecipe(Node lemma, Node originalLemma, bool preprocess, theory::TheoryId theoryId) {
   // During CNF conversion, conjunctions will be broken down into
   // multiple lemmas. In order for the recipes to match, we have to do
@@ -188,6 +222,13 @@ theory::LemmaStatus TheoryEngine::EngineOutputChannel::splitLemma(
   ++d_statistics.lemmas;
   d_engine->d_outputChannelUsed = true;
 
+  Node redundant = filterLemma(lemma, removable);
+  if (!redundant.isNull())
+  {
+    return theory::LemmaStatus(redundant,
+                               d_engine->d_userContext->getLevel());
+  }
+
   Debug("pf::explain") << "TheoryEngine::EngineOutputChannel::splitLemma( "
                        << lemma << " )" << std::endl;
   theory::LemmaStatus result =
@@ -215,6 +256,17 @@ void TheoryEngine::EngineOutputChannel::conflict(TNode conflictNode,
   d_engine->conflict(conflictNode, d_theory);
 }
 
+eq::EqualityEngine* TheoryEngine::getCentralEqualityEngine(
+    TheoryId theory, eq::EqualityEngineNotify* notify)
+{
+  if (!d_centralEqualityEngine)
+  {
+    return nullptr;
+  }
+  d_centralEqualityEngine->addTheory(theory, notify);
+  return d_centralEqualityEngine->getEqualityEngine();
+}
+
 void TheoryEngine::finishInit() {
 
   //initialize the quantifiers engine, master equality engine, model, model builder
@@ -230,6 +282,12 @@ void TheoryEngine::finishInit() {
         d_theoryTable[theoryId]->setMasterEqualityEngine(d_masterEqualityEngine);
       }
     }
+    // The theories using the central equality engine leave it to us
+    if (d_centralEqualityEngine)
+    {
+      d_centralEqualityEngine->getEqualityEngine()->setMasterEqualityEngine(
+          d_masterEqualityEngine);
+    }
 
     d_curr_model_builder = d_quantEngine->getModelBuilder();
     d_curr_model = d_quantEngine->getModel();
@@ -290,6 +348,9 @@ TheoryEngine::TheoryEngine(context::Context* context,
       d_logicInfo(logicInfo),
       d_sharedTerms(this, context),
       d_masterEqualityEngine(nullptr),
+      d_centralEqualityEngine(
+          options::eeCentral() ? new eq::CentralEqualityEngine(context)
+                               : nullptr),
       d_masterEENotify(*this),
       d_quantEngine(nullptr),
       d_decManager(new DecisionManager(context)),
@@ -310,8 +371,14 @@ TheoryEngine::TheoryEngine(context::Context* context,
       d_propagatedLiterals(context),
       d_propagatedLiteralsIndex(context, 0),
       d_atomRequests(context),
+      d_lemmaFilter(options::lemmaFilter()
+                        ? new LemmaFilter(userContext,
+                                          options::lemmaFilterWindow())
+                        : nullptr),
       d_tform_remover(iteRemover),
       d_combineTheoriesTime("TheoryEngine::combineTheoriesTime"),
+      d_combineTheoriesSplits("TheoryEngine::combineTheoriesSplits", 0),
+      d_combineTheoriesSkipped("TheoryEngine::combineTheoriesSkipped", 0),
       d_true(),
       d_false(),
       d_interrupted(false),
@@ -330,9 +397,14 @@ TheoryEngine::TheoryEngine(context::Context* context,
   {
     d_theoryTable[theoryId] = NULL;
     d_theoryOut[theoryId] = NULL;
+    d_propagationInterval[theoryId] = 1;
   }
+  d_propagationRound = 0;
+  setPropagationIntervals(options::theoryPropIntervals());
 
   smtStatisticsRegistry()->registerStat(&d_combineTheoriesTime);
+  smtStatisticsRegistry()->registerStat(&d_combineTheoriesSplits);
+  smtStatisticsRegistry()->registerStat(&d_combineTheoriesSkipped);
   d_true = NodeManager::currentNM()->mkConst<bool>(true);
   d_false = NodeManager::currentNM()->mkConst<bool>(false);
 
@@ -365,6 +437,8 @@ TheoryEngine::~TheoryEngine() {
   delete d_masterEqualityEngine;
 
   smtStatisticsRegistry()->unregisterStat(&d_combineTheoriesTime);
+  smtStatisticsRegistry()->unregisterStat(&d_combineTheoriesSplits);
+  smtStatisticsRegistry()->unregisterStat(&d_combineTheoriesSkipped);
   smtStatisticsRegistry()->unregisterStat(&d_arithSubstitutionsAdded);
 }
 
@@ -520,10 +594,14 @@ void TheoryEngine::check(Theory::Effort effort) {
 #endif
 #define CVC4_FOR_EACH_THEORY_STATEMENT(THEORY) \
     if (theory::TheoryTraits<THEORY>::hasCheck && d_logicInfo.isTheoryEnabled(THEORY)) { \
-       theoryOf(THEORY)->check(effort); \
-       if (d_inConflict) { \
-         Debug("conflict") << THEORY << " in conflict. " << std::endl; \
-         break; \
+       if (checkCutoff && d_lemmasAdded) { \
+         ++d_theoryOut[THEORY]->d_statistics.checksCutoff; \
+       } else { \
+         theoryOf(THEORY)->check(effort); \
+         if (d_inConflict) { \
+           Debug("conflict") << THEORY << " in conflict. " << std::endl; \
+           break; \
+         } \
        } \
     }
 
@@ -544,6 +622,12 @@ void TheoryEngine::check(Theory::Effort effort) {
       d_factsAsserted = true;
     }
 
+    // Once a theory has added a lemma at full effort, the SAT solver will
+    // call us again, so the (possibly expensive) checks of the remaining
+    // theories can wait for that round
+    const bool checkCutoff =
+        Theory::fullEffort(effort) && options::theoryCheckCutoff();
+
     // Check until done
     while (d_factsAsserted && !d_inConflict && !d_lemmasAdded) {
 
@@ -713,24 +797,66 @@ void TheoryEngine::combineTheories() {
     //   es == EQUALITY_UNKNOWN ? "EQUALITY_UNKNOWN" :
     //    "Unexpected case") << endl;
 
+    bool phase = true;
+    if (options::modelBasedTheoryCombination()
+        && !needsCombinationSplit(carePair, phase))
+    {
+      Debug("combineTheories") << "TheoryEngine::combineTheories(): models agree" << endl;
+      ++d_combineTheoriesSkipped;
+      continue;
+    }
+
     // We need to split on it
     Debug("combineTheories") << "TheoryEngine::combineTheories(): requesting a split " << endl;
+    ++d_combineTheoriesSplits;
 
     lemma(equality.orNode(equality.notNode()), RULE_INVALID, false, false, false, carePair.theory);
 
-    // This code is supposed to force preference to follow what the theory models already have
-    // but it doesn't seem to make a big difference - need to explore more -Clark
-    // if (true) {
-    //   if (es == EQUALITY_TRUE || es == EQUALITY_TRUE_IN_MODEL) {
+    // Try the value of the equality in the model of the owner first (always
+    // true in care-graph combination)
     Node e = ensureLiteral(equality);
-    d_propEngine->requirePhase(e, true);
-    //   }
-    //   else if (es == EQUALITY_FALSE_IN_MODEL) {
-    //     Node e = ensureLiteral(equality);
-    //     d_propEngine->requirePhase(e, false);
-    //   }
-    // }
+    d_propEngine->requirePhase(e, phase);
+  }
+}
+
+bool TheoryEngine::needsCombinationSplit(const CarePair& carePair, bool& phase)
+{
+  TNode a = carePair.a;
+  TNode b = carePair.b;
+
+  // The status in the model of the theory owning the type of the terms
+  switch (getEqualityStatus(a, b))
+  {
+    case EQUALITY_TRUE_AND_PROPAGATED:
+    case EQUALITY_FALSE_AND_PROPAGATED:
+      // Everybody knows already
+      return false;
+    case EQUALITY_TRUE:
+    case EQUALITY_TRUE_IN_MODEL: phase = true; break;
+    case EQUALITY_FALSE:
+    case EQUALITY_FALSE_IN_MODEL:
+      phase = false;
+      // The models of the theories may not agree on the values of the terms
+      // of a finite sort, or of any sort when finite models are looked for
+      if (options::finiteModelFind() || a.getType().isInterpretedFinite())
+      {
+        return true;
+      }
+      break;
+    default:
+      // No model to agree with
+      phase = true;
+      return true;
   }
+
+  // The theory that cares about the pair must agree
+  EqualityStatus status = theoryOf(carePair.theory)->getEqualityStatus(a, b);
+  bool equal = status == EQUALITY_TRUE_AND_PROPAGATED
+               || status == EQUALITY_TRUE || status == EQUALITY_TRUE_IN_MODEL;
+  Debug("combineTheories") << "TheoryEngine::needsCombinationSplit(): owner says "
+                           << phase << ", " << carePair.theory << " says "
+                           << status << endl;
+  return equal != phase;
 }
 
 void TheoryEngine::propagate(Theory::Effort effort) {
@@ -743,12 +869,24 @@ void TheoryEngine::propagate(Theory::Effort effort) {
 #endif
 #define CVC4_FOR_EACH_THEORY_STATEMENT(THEORY) \
   if (theory::TheoryTraits<THEORY>::hasPropagate && d_logicInfo.isTheoryEnabled(THEORY)) { \
-    theoryOf(THEORY)->propagate(effort); \
+    if (fullEffort || d_propagationRound % d_propagationInterval[THEORY] == 0) { \
+      ++d_theoryOut[THEORY]->d_statistics.propagationRounds; \
+      theoryOf(THEORY)->propagate(effort); \
+    } else { \
+      ++d_theoryOut[THEORY]->d_statistics.propagationRoundsDeferred; \
+    } \
   }
 
   // Reset the interrupt flag
   d_interrupted = false;
 
+  // The deferred propagations are always done at full effort
+  const bool fullEffort = Theory::fullEffort(effort);
+  if (!fullEffort)
+  {
+    ++d_propagationRound;
+  }
+
   // Propagate for each theory using the statement above
   CVC4_FOR_EACH_THEORY;
 
@@ -772,6 +910,46 @@ void TheoryEngine::propagate(Theory::Effort effort) {
   }
 }
 
+void TheoryEngine::setPropagationIntervals(const std::string& intervals)
+{
+  std::stringstream ss(intervals);
+  std::string item;
+  while (std::getline(ss, item, ','))
+  {
+    size_t colon = item.find(':');
+    std::string name = item.substr(0, colon);
+    int interval = 0;
+    if (colon != std::string::npos)
+    {
+      std::stringstream is(item.substr(colon + 1));
+      is >> interval;
+      if (is.fail() || !is.eof())
+      {
+        interval = 0;
+      }
+    }
+    TheoryId theoryId = THEORY_FIRST;
+    for (; theoryId < THEORY_LAST; ++theoryId)
+    {
+      // the statistics prefix is theory::<name>
+      if (getStatsPrefix(theoryId) == "theory::" + name)
+      {
+        break;
+      }
+    }
+    if (theoryId == THEORY_LAST || interval < 1)
+    {
+      throw OptionException("invalid entry `" + item
+                            + "' in --theory-prop-intervals, expected "
+                              "<theory>:<positive number>, e.g. arith:4");
+    }
+    Trace("theory::propagate") << "TheoryEngine: " << theoryId
+                               << " propagates every " << interval
+                               << " rounds" << std::endl;
+    d_propagationInterval[theoryId] = interval;
+  }
+}
+
 Node TheoryEngine::getNextDecisionRequest()
 {
   return d_decManager->getNextDecisionRequest();
@@ -1996,6 +2174,32 @@ void TheoryEngine::staticInitializeBVOptions(
   }
 }
 
+bool TheoryEngine::explainByCentralUser(
+    std::vector<NodeTheoryPair>& explanationVector,
+    const NodeTheoryPair& toExplain)
+{
+  for (TheoryId theory = THEORY_FIRST; theory < THEORY_LAST; ++theory)
+  {
+    if (theory == toExplain.theory
+        || !d_centralEqualityEngine->hasTheory(theory))
+    {
+      continue;
+    }
+    PropagationMap::const_iterator find = d_propagationMap.find(
+        NodeTheoryPair(toExplain.node, theory, toExplain.timestamp));
+    if (find != d_propagationMap.end()
+        && (*find).second.timestamp < toExplain.timestamp)
+    {
+      Debug("theory::explain") << "\tTerm was asserted to " << theory
+                               << ", which shares the equality engine"
+                               << std::endl;
+      explanationVector.push_back((*find).second);
+      return true;
+    }
+  }
+  return false;
+}
+
 void TheoryEngine::getExplanation(std::vector<NodeTheoryPair>& explanationVector, LemmaProofRecipe* proofRecipe) {
   Assert(explanationVector.size() > 0);
 
@@ -2072,6 +2276,13 @@ void TheoryEngine::getExplanation(std::vector<NodeTheoryPair>& explanationVector
         continue;
       }
     }
+    else if (d_centralEqualityEngine
+             && d_centralEqualityEngine->hasTheory(toExplain.theory)
+             && explainByCentralUser(explanationVector, toExplain))
+    {
+      ++i;
+      continue;
+    }
 
     // It was produced by the theory, so ask for an explanation
     Node explanation;
@@ -2279,13 +2490,24 @@ TheoryEngine::Statistics::Statistics(theory::TheoryId theory):
     propagations(getStatsPrefix(theory) + "::propagations", 0),
     lemmas(getStatsPrefix(theory) + "::lemmas", 0),
     requirePhase(getStatsPrefix(theory) + "::requirePhase", 0),
-    restartDemands(getStatsPrefix(theory) + "::restartDemands", 0)
+    restartDemands(getStatsPrefix(theory) + "::restartDemands", 0),
+    checksCutoff(getStatsPrefix(theory) + "::checksCutoff", 0),
+    lemmasDuplicate(getStatsPrefix(theory) + "::lemmasDuplicate", 0),
+    lemmasSubsumed(getStatsPrefix(theory) + "::lemmasSubsumed", 0),
+    propagationRounds(getStatsPrefix(theory) + "::propagationRounds", 0),
+    propagationRoundsDeferred(
+        getStatsPrefix(theory) + "::propagationRoundsDeferred", 0)
 {
   smtStatisticsRegistry()->registerStat(&conflicts);
   smtStatisticsRegistry()->registerStat(&propagations);
   smtStatisticsRegistry()->registerStat(&lemmas);
   smtStatisticsRegistry()->registerStat(&requirePhase);
   smtStatisticsRegistry()->registerStat(&restartDemands);
+  smtStatisticsRegistry()->registerStat(&checksCutoff);
+  smtStatisticsRegistry()->registerStat(&lemmasDuplicate);
+  smtStatisticsRegistry()->registerStat(&lemmasSubsumed);
+  smtStatisticsRegistry()->registerStat(&propagationRounds);
+  smtStatisticsRegistry()->registerStat(&propagationRoundsDeferred);
 }
 
 TheoryEngine::Statistics::~Statistics() {
@@ -2294,6 +2516,11 @@ TheoryEngine::Statistics::~Statistics() {
   smtStatisticsRegistry()->unregisterStat(&lemmas);
   smtStatisticsRegistry()->unregisterStat(&requirePhase);
   smtStatisticsRegistry()->unregisterStat(&restartDemands);
+  smtStatisticsRegistry()->unregisterStat(&checksCutoff);
+  smtStatisticsRegistry()->unregisterStat(&lemmasDuplicate);
+  smtStatisticsRegistry()->unregisterStat(&lemmasSubsumed);
+  smtStatisticsRegistry()->unregisterStat(&propagationRounds);
+  smtStatisticsRegistry()->unregisterStat(&propagationRoundsDeferred);
 }
 
 }/* CVC4 namespace */
@@ -37,12 +37,14 @@
 #include "theory/atom_requests.h"
 #include "theory/decision_manager.h"
 #include "theory/interrupted.h"
+#include "theory/lemma_filter.h"
 #include "theory/rewriter.h"
 #include "theory/shared_terms_database.h"
 #include "theory/sort_inference.h"
 #include "theory/substitutions.h"
 #include "theory/term_registration_visitor.h"
 #include "theory/theory.h"
+#include "theory/uf/central_equality_engine.h"
 #include "theory/uf/equality_engine.h"
 #include "theory/valuation.h"
 #include "util/hash.h"
@@ -150,6 +152,12 @@ class TheoryEngine {
    */
   theory::eq::EqualityEngine* d_masterEqualityEngine;
 
+  /**
+   * Equality engine shared by the theories that support it (--ee-central),
+   * null if each theory has its own.
+   */
+  std::unique_ptr<theory::eq::CentralEqualityEngine> d_centralEqualityEngine;
+
   /** notify class for master equality engine */
   class NotifyClass : public theory::eq::EqualityEngineNotify {
     TheoryEngine& d_te;
@@ -254,6 +262,12 @@ class TheoryEngine {
 
    public:
     IntStat conflicts, propagations, lemmas, requirePhase, restartDemands;
+    /** Full effort checks skipped because of --theory-check-cutoff */
+    IntStat checksCutoff;
+    /** Lemmas dropped by --lemma-filter */
+    IntStat lemmasDuplicate, lemmasSubsumed;
+    /** Propagation rounds run and deferred (see --theory-prop-intervals) */
+    IntStat propagationRounds, propagationRoundsDeferred;
 
     Statistics(theory::TheoryId theory);
     ~Statistics();
@@ -279,6 +293,13 @@ class TheoryEngine {
     /** The theory owning this channel. */
     theory::TheoryId d_theory;
 
+    /**
+     * Returns the rewritten lemma if the lemma filter of the engine finds
+     * it redundant, in which case it counts as sent. Returns the null node
+     * otherwise.
+     */
+    Node filterLemma(TNode lemma, bool removable);
+
    public:
     EngineOutputChannel(TheoryEngine* engine, theory::TheoryId theory)
         : d_engine(engine), d_statistics(theory), d_theory(theory) {}
@@ -418,6 +439,19 @@ class TheoryEngine {
    */
   void propagate(theory::Theory::Effort effort);
 
+  /**
+   * Below full effort, a theory only propagates in the rounds whose number
+   * is a multiple of its interval, so the expensive propagators work on
+   * batches of updates.
+   */
+  unsigned d_propagationInterval[theory::THEORY_LAST];
+
+  /** Number of propagation rounds below full effort */
+  unsigned d_propagationRound;
+
+  /** Set the propagation intervals from the --theory-prop-intervals list */
+  void setPropagationIntervals(const std::string& intervals);
+
   /**
    * A variable to mark if we added any lemmas.
    */
@@ -435,6 +469,9 @@ class TheoryEngine {
   /** Atom requests from lemmas */
   AtomRequests d_atomRequests;
 
+  /** Filter for redundant lemmas (if --lemma-filter) */
+  std::unique_ptr<theory::LemmaFilter> d_lemmaFilter;
+
   /**
    * Adds a new lemma, returning its status.
    * @param node the lemma
@@ -459,6 +496,10 @@ class TheoryEngine {
 
   /** Time spent in theory combination */
   TimerStat d_combineTheoriesTime;
+  /** Number of splits requested by theory combination */
+  IntStat d_combineTheoriesSplits;
+  /** Number of care pairs skipped by model-based theory combination */
+  IntStat d_combineTheoriesSkipped;
 
   Node d_true;
   Node d_false;
@@ -607,6 +648,15 @@ public:
    */
   void getExplanation(std::vector<NodeTheoryPair>& explanationVector, LemmaProofRecipe* lemmaProofRecipe);
 
+  /**
+   * An explanation of a theory using the central equality engine may contain
+   * literals that were only asserted to another user of the engine. If
+   * toExplain is one, push what it was asserted from to explanationVector and
+   * return true.
+   */
+  bool explainByCentralUser(std::vector<NodeTheoryPair>& explanationVector,
+                            const NodeTheoryPair& toExplain);
+
 public:
 
   /**
@@ -682,6 +732,16 @@ public:
    */
   void combineTheories();
 
+  /**
+   * Does the given care pair need a split in model-based theory combination?
+   * It does not if the model of the theory owning the type of the terms
+   * agrees with the theory that cares about the pair; the other theories see
+   * the terms as disequal unless told otherwise, which is only safe for terms
+   * of an infinite sort without finite model finding. If a split is needed,
+   * phase is set to the value of the equality in the model of the owner.
+   */
+  bool needsCombinationSplit(const theory::CarePair& carePair, bool& phase);
+
   /**
    * Calls ppStaticLearn() on all theories, accumulating their
    * combined contributions in the "learned" builder.
@@ -883,6 +943,13 @@ public:
 
   theory::eq::EqualityEngine* getMasterEqualityEngine() { return d_masterEqualityEngine; }
 
+  /**
+   * Get the central equality engine for the given theory, registering its
+   * notification class. Returns null if each theory has its own engine.
+   */
+  theory::eq::EqualityEngine* getCentralEqualityEngine(
+      theory::TheoryId theory, theory::eq::EqualityEngineNotify* notify);
+
   RemoveTermFormulas* getTermFormulaRemover() { return &d_tform_remover; }
 
   SortInference* getSortInference() { return &d_sortInfer; }
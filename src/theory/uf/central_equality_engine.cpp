@@ -0,0 +1,111 @@
+/*********************                                                        */
+/*! \file central_equality_engine.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief An equality engine shared by several theories
+ **
+ ** Implementation of the dispatch of the notifications of the central
+ ** equality engine.
+ **/
+
+#include "theory/uf/central_equality_engine.h"
+
+#include "theory/theory.h"
+
+namespace CVC4 {
+namespace theory {
+namespace eq {
+
+CentralEqualityEngine::CentralEqualityEngine(context::Context* c)
+    : d_equalityEngine(*this, c, "theory::central::ee", true)
+{
+  for (unsigned i = 0; i < THEORY_LAST; ++i)
+  {
+    d_notify[i] = nullptr;
+  }
+}
+
+void CentralEqualityEngine::addTheory(TheoryId id,
+                                      EqualityEngineNotify* notify)
+{
+  Assert(d_notify[id] == nullptr);
+  Debug("equality::central") << "CentralEqualityEngine::addTheory(" << id
+                             << ")" << std::endl;
+  d_notify[id] = notify;
+  d_theories.push_back(notify);
+}
+
+EqualityEngineNotify* CentralEqualityEngine::getOwner(TNode atom) const
+{
+  Assert(!d_theories.empty());
+  EqualityEngineNotify* owner = d_notify[Theory::theoryOf(atom)];
+  return owner != nullptr ? owner : d_theories[0];
+}
+
+bool CentralEqualityEngine::eqNotifyTriggerEquality(TNode equality,
+                                                    bool value)
+{
+  return getOwner(equality)->eqNotifyTriggerEquality(equality, value);
+}
+
+bool CentralEqualityEngine::eqNotifyTriggerPredicate(TNode predicate,
+                                                     bool value)
+{
+  return getOwner(predicate)->eqNotifyTriggerPredicate(predicate, value);
+}
+
+bool CentralEqualityEngine::eqNotifyTriggerTermEquality(TheoryId tag,
+                                                        TNode t1,
+                                                        TNode t2,
+                                                        bool value)
+{
+  Assert(d_notify[tag] != nullptr);
+  return d_notify[tag]->eqNotifyTriggerTermEquality(tag, t1, t2, value);
+}
+
+void CentralEqualityEngine::eqNotifyConstantTermMerge(TNode t1, TNode t2)
+{
+  Assert(!d_theories.empty());
+  d_theories[0]->eqNotifyConstantTermMerge(t1, t2);
+}
+
+void CentralEqualityEngine::eqNotifyNewClass(TNode t)
+{
+  for (EqualityEngineNotify* notify : d_theories)
+  {
+    notify->eqNotifyNewClass(t);
+  }
+}
+
+void CentralEqualityEngine::eqNotifyPreMerge(TNode t1, TNode t2)
+{
+  for (EqualityEngineNotify* notify : d_theories)
+  {
+    notify->eqNotifyPreMerge(t1, t2);
+  }
+}
+
+void CentralEqualityEngine::eqNotifyPostMerge(TNode t1, TNode t2)
+{
+  for (EqualityEngineNotify* notify : d_theories)
+  {
+    notify->eqNotifyPostMerge(t1, t2);
+  }
+}
+
+void CentralEqualityEngine::eqNotifyDisequal(TNode t1, TNode t2, TNode reason)
+{
+  for (EqualityEngineNotify* notify : d_theories)
+  {
+    notify->eqNotifyDisequal(t1, t2, reason);
+  }
+}
+
+}  // namespace eq
+}  // namespace theory
+}  // namespace CVC4
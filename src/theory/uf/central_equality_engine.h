@@ -0,0 +1,89 @@
+/*********************                                                        */
+/*! \file central_equality_engine.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief An equality engine shared by several theories
+ **
+ ** An equality engine shared by several theories, with the notifications
+ ** dispatched to the theories that use it.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__UF__CENTRAL_EQUALITY_ENGINE_H
+#define CVC4__THEORY__UF__CENTRAL_EQUALITY_ENGINE_H
+
+#include <vector>
+
+#include "context/context.h"
+#include "expr/kind.h"
+#include "expr/node.h"
+#include "theory/uf/equality_engine.h"
+
+namespace CVC4 {
+namespace theory {
+namespace eq {
+
+/**
+ * An equality engine that is used by several theories instead of each of them
+ * keeping a copy of the terms they have in common (--ee-central).
+ *
+ * The notifications are dispatched as follows:
+ * - trigger equalities and predicates go to the theory owning the atom, or to
+ *   the first theory if the owner does not use this engine.
+ * - trigger term equalities go to the theory of the tag.
+ * - a merge of constants goes to the first theory, which reports the conflict.
+ * - new classes, merges and disequalities go to all the theories, which filter
+ *   them (by type) as they already do with their own engine.
+ */
+class CentralEqualityEngine : public EqualityEngineNotify
+{
+ public:
+  CentralEqualityEngine(context::Context* c);
+
+  /** Get the equality engine */
+  EqualityEngine* getEqualityEngine() { return &d_equalityEngine; }
+
+  /**
+   * Register the theory with the given id and notification class as a user
+   * of the engine.
+   */
+  void addTheory(TheoryId id, EqualityEngineNotify* notify);
+
+  /** Is the theory with the given id a user of the engine? */
+  bool hasTheory(TheoryId id) const { return d_notify[id] != nullptr; }
+
+  bool eqNotifyTriggerEquality(TNode equality, bool value) override;
+  bool eqNotifyTriggerPredicate(TNode predicate, bool value) override;
+  bool eqNotifyTriggerTermEquality(TheoryId tag,
+                                   TNode t1,
+                                   TNode t2,
+                                   bool value) override;
+  void eqNotifyConstantTermMerge(TNode t1, TNode t2) override;
+  void eqNotifyNewClass(TNode t) override;
+  void eqNotifyPreMerge(TNode t1, TNode t2) override;
+  void eqNotifyPostMerge(TNode t1, TNode t2) override;
+  void eqNotifyDisequal(TNode t1, TNode t2, TNode reason) override;
+
+ private:
+  /** Get the notification class of the theory owning the atom */
+  EqualityEngineNotify* getOwner(TNode atom) const;
+
+  /** The notification classes of the theories, by id */
+  EqualityEngineNotify* d_notify[THEORY_LAST];
+  /** The theories in the order they were added */
+  std::vector<EqualityEngineNotify*> d_theories;
+  /** The equality engine */
+  EqualityEngine d_equalityEngine;
+}; /* class CentralEqualityEngine */
+
+}  // namespace eq
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__UF__CENTRAL_EQUALITY_ENGINE_H */
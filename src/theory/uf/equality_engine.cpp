@@ -17,6 +17,7 @@
 
 #include "theory/uf/equality_engine.h"
 
+#include "options/uf_options.h"
 #include "smt/smt_statistics_registry.h"
 
 namespace CVC4 {
@@ -27,12 +28,16 @@ EqualityEngine::Statistics::Statistics(std::string name)
     : mergesCount(name + "::mergesCount", 0),
       termsCount(name + "::termsCount", 0),
       functionTermsCount(name + "::functionTermsCount", 0),
-      constantTermsCount(name + "::constantTermsCount", 0)
+      constantTermsCount(name + "::constantTermsCount", 0),
+      explanationCacheHits(name + "::explanationCacheHits", 0),
+      explanationShortcuts(name + "::explanationShortcuts", 0)
 {
   smtStatisticsRegistry()->registerStat(&mergesCount);
   smtStatisticsRegistry()->registerStat(&termsCount);
   smtStatisticsRegistry()->registerStat(&functionTermsCount);
   smtStatisticsRegistry()->registerStat(&constantTermsCount);
+  smtStatisticsRegistry()->registerStat(&explanationCacheHits);
+  smtStatisticsRegistry()->registerStat(&explanationShortcuts);
 }
 
 EqualityEngine::Statistics::~Statistics() {
@@ -40,6 +45,8 @@ EqualityEngine::Statistics::~Statistics() {
   smtStatisticsRegistry()->unregisterStat(&termsCount);
   smtStatisticsRegistry()->unregisterStat(&functionTermsCount);
   smtStatisticsRegistry()->unregisterStat(&constantTermsCount);
+  smtStatisticsRegistry()->unregisterStat(&explanationCacheHits);
+  smtStatisticsRegistry()->unregisterStat(&explanationShortcuts);
 }
 
 /**
@@ -122,6 +129,11 @@ EqualityEngine::EqualityEngine(context::Context* context, std::string name, bool
 , d_deducedDisequalitiesSize(context, 0)
 , d_deducedDisequalityReasonsSize(context, 0)
 , d_propagatedDisequalities(context)
+, d_explanationShortcuts(context)
+, d_explanationCache(context)
+, d_explanationReasons(context)
+, d_explanationLocalHits(0)
+, d_explanationLimit(null_edge)
 , d_name(name)
 {
   init();
@@ -147,6 +159,11 @@ EqualityEngine::EqualityEngine(EqualityEngineNotify& notify, context::Context* c
 , d_deducedDisequalitiesSize(context, 0)
 , d_deducedDisequalityReasonsSize(context, 0)
 , d_propagatedDisequalities(context)
+, d_explanationShortcuts(context)
+, d_explanationCache(context)
+, d_explanationReasons(context)
+, d_explanationLocalHits(0)
+, d_explanationLimit(null_edge)
 , d_name(name)
 {
   init();
@@ -215,7 +232,7 @@ EqualityNodeId EqualityEngine::newNode(TNode node) {
 
   // Register the new id of the term
   EqualityNodeId newId = d_nodes.size();
-  d_nodeIds[node] = newId;
+  d_nodeIds.set(node.getId(), newId);
   // Add the node to it's position
   d_nodes.push_back(node);
   // Note if this is an application or not
@@ -371,12 +388,14 @@ void EqualityEngine::addTermInternal(TNode t, bool isOperator) {
 }
 
 bool EqualityEngine::hasTerm(TNode t) const {
-  return d_nodeIds.find(t) != d_nodeIds.end();
+  EqualityNodeId id = d_nodeIds.find(t.getId());
+  // The null node shares its id with the first node created
+  return id != null_id && d_nodes[id] == t;
 }
 
 EqualityNodeId EqualityEngine::getNodeId(TNode node) const {
   Assert(hasTerm(node), node.toString().c_str());
-  return (*d_nodeIds.find(node)).second;
+  return d_nodeIds.find(node.getId());
 }
 
 EqualityNode& EqualityEngine::getEqualityNode(TNode t) {
@@ -433,6 +452,20 @@ void EqualityEngine::assertEquality(TNode eq, bool polarity, TNode reason, unsig
   if (polarity) {
     // If two terms are already equal, don't assert anything
     if (hasTerm(eq[0]) && hasTerm(eq[1]) && areEqual(eq[0], eq[1])) {
+      // But remember the equality as a shorter way to explain it, along
+      // with the number of edges at this point. It can only explain what
+      // became true after it was asserted, see getExplanation().
+      if (options::eeExplainShortcuts() && pid == MERGED_THROUGH_EQUALITY
+          && eq[0] != eq[1])
+      {
+        EqualityPair pair =
+            std::minmax(getNodeId(eq[0]), getNodeId(eq[1]));
+        if (d_explanationShortcuts.find(pair) == d_explanationShortcuts.end())
+        {
+          d_explanationShortcuts.insert(
+              pair, std::make_pair(Node(reason), d_equalityEdges.size()));
+        }
+      }
       return;
     }
     // Add equality between terms
@@ -857,7 +890,7 @@ void EqualityEngine::backtrack() {
     for(int i = d_nodes.size() - 1, i_end = (int)d_nodesCount; i >= i_end; -- i) {
       // Remove from the node -> id map
       Debug("equality") << d_name << "::eq::backtrack(): removing node " << d_nodes[i] << std::endl;
-      d_nodeIds.erase(d_nodes[i]);
+      d_nodeIds.erase(d_nodes[i].getId());
 
       const FunctionApplication& app = d_applications[i].original;
       if (!app.isNull()) {
@@ -1048,6 +1081,92 @@ void EqualityEngine::getExplanation(
     std::vector<TNode>& equalities,
     std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*>& cache,
     EqProof* eqp) const
+{
+  // The shortcuts and the cache only give the literals, not the proofs
+  if (eqp || t1Id == t2Id
+      || (!options::eeExplainCache() && !options::eeExplainShortcuts()))
+  {
+    getExplanationPath(t1Id, t2Id, equalities, cache, eqp);
+    return;
+  }
+
+  std::pair<EqualityNodeId, EqualityNodeId> cacheKey = std::minmax(t1Id, t2Id);
+  if (cache.find(cacheKey) != cache.end())
+  {
+    // Already explained in this call
+    ++d_explanationLocalHits;
+    return;
+  }
+
+  // The outermost call sets the limit on the shortcuts once it has found its
+  // path, and lifts it when done
+  bool outermost = d_explanationLimit == null_edge;
+
+  // The explanation of a propagated literal may only use literals asserted
+  // before it, so a shortcut is only used if it was recorded before the edge
+  // that made the terms of the outermost call equal. This also keeps an
+  // equality that is asserted back after being propagated from explaining
+  // itself.
+  if (options::eeExplainShortcuts() && !outermost)
+  {
+    ShortcutsMap::const_iterator it = d_explanationShortcuts.find(cacheKey);
+    if (it != d_explanationShortcuts.end()
+        && (*it).second.second <= d_explanationLimit)
+    {
+      Debug("equality") << d_name << "::eq::getExplanation(): shortcut "
+                        << (*it).second.first << std::endl;
+      cache[cacheKey] = nullptr;
+      equalities.push_back((*it).second.first);
+      ++d_stats.explanationShortcuts;
+      // The explanation now depends on the limit, so it is not cached
+      ++d_explanationLocalHits;
+      return;
+    }
+  }
+
+  if (options::eeExplainCache())
+  {
+    ExplanationCache::const_iterator it = d_explanationCache.find(cacheKey);
+    if (it != d_explanationCache.end())
+    {
+      cache[cacheKey] = nullptr;
+      for (size_t i = (*it).second.first; i < (*it).second.second; ++i)
+      {
+        equalities.push_back(d_explanationReasons[i]);
+      }
+      ++d_stats.explanationCacheHits;
+      return;
+    }
+  }
+
+  size_t start = equalities.size();
+  unsigned localHits = d_explanationLocalHits;
+  getExplanationPath(t1Id, t2Id, equalities, cache, eqp);
+  if (outermost)
+  {
+    d_explanationLimit = null_edge;
+  }
+
+  // If parts were skipped because they were explained earlier in this call,
+  // the literals we got are not the full explanation
+  if (options::eeExplainCache() && localHits == d_explanationLocalHits)
+  {
+    size_t begin = d_explanationReasons.size();
+    for (size_t i = start; i < equalities.size(); ++i)
+    {
+      d_explanationReasons.push_back(equalities[i]);
+    }
+    d_explanationCache.insert(
+        cacheKey, std::make_pair(begin, d_explanationReasons.size()));
+  }
+}
+
+void EqualityEngine::getExplanationPath(
+    EqualityNodeId t1Id,
+    EqualityNodeId t2Id,
+    std::vector<TNode>& equalities,
+    std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*>& cache,
+    EqProof* eqp) const
 {
   Trace("eq-exp") << d_name << "::eq::getExplanation(" << d_nodes[t1Id] << ","
                   << d_nodes[t2Id] << ") size = " << cache.size() << std::endl;
@@ -1164,6 +1283,20 @@ void EqualityEngine::getExplanation(
 
           Debug("equality") << d_name << "::eq::getExplanation(): path found: " << std::endl;
 
+          // The terms of the outermost explanation became equal with the
+          // last edge of their path, this limits the shortcuts below
+          if (!eqp && options::eeExplainShortcuts()
+              && d_explanationLimit == null_edge)
+          {
+            d_explanationLimit = currentEdge;
+            for (size_t i = currentIndex; bfsQueue[i].edgeId != null_edge;
+                 i = bfsQueue[i].previousIndex)
+            {
+              d_explanationLimit =
+                  std::max(d_explanationLimit, bfsQueue[i].edgeId);
+            }
+          }
+
           std::vector<std::shared_ptr<EqProof>> eqp_trans;
 
           // Reconstruct the path
@@ -27,6 +27,7 @@
 
 #include "base/output.h"
 #include "context/cdhashmap.h"
+#include "context/cdlist.h"
 #include "context/cdo.h"
 #include "expr/kind_map.h"
 #include "expr/node.h"
@@ -218,6 +219,10 @@ public:
     IntStat functionTermsCount;
     /** Number of constant terms managed by the system */
     IntStat constantTermsCount;
+    /** Number of explanations taken from the explanation cache */
+    IntStat explanationCacheHits;
+    /** Number of explanations replaced by an asserted equality */
+    IntStat explanationShortcuts;
 
     Statistics(std::string name);
 
@@ -250,8 +255,8 @@ private:
   /** Objects that need to be notified during equality path reconstruction */
   std::map<unsigned, const PathReconstructionNotify*> d_pathReconstructionTriggers;
 
-  /** Map from nodes to their ids */
-  std::unordered_map<TNode, EqualityNodeId, TNodeHashFunction> d_nodeIds;
+  /** Map from nodes to their ids (by the ids of the nodes) */
+  NodeIdTable d_nodeIds;
 
   /** Map from function applications to their ids */
   typedef std::unordered_map<FunctionApplication, EqualityNodeId, FunctionApplicationHashFunction> ApplicationIdsMap;
@@ -495,7 +500,7 @@ private:
   void addTriggerToList(EqualityNodeId nodeId, TriggerId triggerId);
 
   /** Statistics */
-  Statistics d_stats;
+  mutable Statistics d_stats;
 
   /** Add a new function application node to the database, i.e APP t1 t2 */
   EqualityNodeId newApplicationNode(TNode original, EqualityNodeId t1, EqualityNodeId t2, FunctionApplicationType type);
@@ -535,6 +540,18 @@ private:
       std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*>& cache,
       EqProof* eqp) const;
 
+  /**
+   * Get the explanation of t1 = t2 from the path between them in the equality
+   * graph. The shortcuts and the explanation cache of getExplanation are
+   * consulted before this is called.
+   */
+  void getExplanationPath(
+      EqualityNodeId t1Id,
+      EqualityNodeId t2Id,
+      std::vector<TNode>& equalities,
+      std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*>& cache,
+      EqProof* eqp) const;
+
   /**
    * Print the equality graph.
    */
@@ -672,6 +689,37 @@ private:
   typedef context::CDHashMap<EqualityPair, Theory::Set, EqualityPairHashFunction> PropagatedDisequalitiesMap;
   PropagatedDisequalitiesMap d_propagatedDisequalities;
 
+  /**
+   * Equalities asserted between terms that were already equal, with their
+   * reasons and the number of edges when they were asserted
+   * (--ee-explain-shortcuts). The reason alone explains the equality with
+   * fewer literals than the path in the equality graph.
+   */
+  typedef context::CDHashMap<EqualityPair, std::pair<Node, size_t>, EqualityPairHashFunction> ShortcutsMap;
+  ShortcutsMap d_explanationShortcuts;
+
+  /**
+   * Explanations computed without proofs in this context (--ee-explain-cache),
+   * as ranges of d_explanationReasons. The equality graph only grows until the
+   * context pops, so an explanation stays valid for as long as it is cached.
+   */
+  typedef context::CDHashMap<EqualityPair, std::pair<size_t, size_t>, EqualityPairHashFunction> ExplanationCache;
+  mutable ExplanationCache d_explanationCache;
+  mutable context::CDList<Node> d_explanationReasons;
+
+  /**
+   * Number of hits in the per-call caches of getExplanation. An explanation
+   * computed without such a hit is complete and can go into
+   * d_explanationCache.
+   */
+  mutable unsigned d_explanationLocalHits;
+
+  /**
+   * The last edge of the path of the outermost explanation being computed,
+   * null_edge if none. Only the shortcuts recorded before it can be used.
+   */
+  mutable EqualityEdgeId d_explanationLimit;
+
   /**
    * Has this equality been propagated to anyone.
    */
@@ -22,8 +22,12 @@
 
 #include <string>
 #include <iostream>
+#include <memory>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
+#include "base/cvc4_assert.h"
 #include "util/hash.h"
 
 namespace CVC4 {
@@ -356,6 +360,104 @@ struct TriggerInfo {
       : trigger(trigger), polarity(polarity) {}
 };
 
+/**
+ * Map from the ids of nodes (Node::getId()) to the ids of their equality
+ * nodes. The ids of nodes are global to the node manager, so the terms of an
+ * engine can be spread over a large range. The ranges that hold enough terms
+ * of the engine get a table indexed by the id, where a lookup is two loads
+ * instead of hashing and probing. The terms in the other ranges are kept in a
+ * hash map, and a table is freed when its range is emptied by backtracking.
+ */
+class NodeIdTable {
+ public:
+  /** Get the id of the node with the given id, null_id if not there */
+  EqualityNodeId find(uint64_t nodeId) const {
+    uint64_t page = nodeId >> s_pageBits;
+    if (page < d_pages.size() && d_pages[page]) {
+      return d_pages[page][nodeId & s_pageMask];
+    }
+    SparseMap::const_iterator it = d_sparse.find(nodeId);
+    return it == d_sparse.end() ? null_id : it->second;
+  }
+
+  /** Set the id of the node with the given id */
+  void set(uint64_t nodeId, EqualityNodeId id) {
+    Assert(id != null_id);
+    uint64_t page = nodeId >> s_pageBits;
+    if (page < d_pages.size() && d_pages[page]) {
+      EqualityNodeId& slot = d_pages[page][nodeId & s_pageMask];
+      if (slot == null_id) {
+        ++ d_counts[page];
+      }
+      slot = id;
+      return;
+    }
+    std::pair<SparseMap::iterator, bool> res =
+        d_sparse.insert(std::make_pair(nodeId, id));
+    if (!res.second) {
+      res.first->second = id;
+      return;
+    }
+    if (page >= d_counts.size()) {
+      d_counts.resize(page + 1, 0);
+    }
+    if (++ d_counts[page] < s_denseCount) {
+      return;
+    }
+    // Enough terms in the range, move them to a table
+    if (page >= d_pages.size()) {
+      d_pages.resize(page + 1);
+    }
+    d_pages[page].reset(new EqualityNodeId[s_pageSize]);
+    uint64_t first = page << s_pageBits;
+    for (unsigned i = 0; i < s_pageSize; ++ i) {
+      SparseMap::iterator it = d_sparse.find(first + i);
+      if (it == d_sparse.end()) {
+        d_pages[page][i] = null_id;
+      } else {
+        d_pages[page][i] = it->second;
+        d_sparse.erase(it);
+      }
+    }
+  }
+
+  /**
+   * Remove the node with the given id, if there. A node can be in the
+   * engine more than once, and is then removed by the first of its copies.
+   */
+  void erase(uint64_t nodeId) {
+    uint64_t page = nodeId >> s_pageBits;
+    if (page < d_pages.size() && d_pages[page]) {
+      EqualityNodeId& slot = d_pages[page][nodeId & s_pageMask];
+      if (slot == null_id) {
+        return;
+      }
+      slot = null_id;
+      if (-- d_counts[page] == 0) {
+        d_pages[page].reset();
+      }
+    } else if (d_sparse.erase(nodeId) > 0) {
+      -- d_counts[page];
+    }
+  }
+
+ private:
+  static const unsigned s_pageBits = 8;
+  static const unsigned s_pageSize = 1u << s_pageBits;
+  static const uint64_t s_pageMask = s_pageSize - 1;
+  /** A range gets a table once it holds this many terms */
+  static const unsigned s_denseCount = s_pageSize / 8;
+
+  typedef std::unordered_map<uint64_t, EqualityNodeId> SparseMap;
+
+  /** The tables of the ranges, null if the range has few terms */
+  std::vector<std::unique_ptr<EqualityNodeId[]> > d_pages;
+  /** The number of terms in each range */
+  std::vector<uint16_t> d_counts;
+  /** The terms in the ranges without a table */
+  SparseMap d_sparse;
+};/* class NodeIdTable */
+
 } // namespace eq
 } // namespace theory
 } // namespace CVC4
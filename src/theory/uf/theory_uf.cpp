@@ -27,6 +27,7 @@
 #include "proof/proof_manager.h"
 #include "proof/theory_proof.h"
 #include "proof/uf_proof.h"
+#include "smt/smt_statistics_registry.h"
 #include "theory/theory_model.h"
 #include "theory/type_enumerator.h"
 #include "theory/uf/theory_uf_rewriter.h"
@@ -50,13 +51,22 @@ TheoryUF::TheoryUF(context::Context* c,
       /* The strong theory solver can be notified by EqualityEngine::init(),
        * so make sure it's initialized first. */
       d_thss(NULL),
-      d_equalityEngine(d_notify, c, instanceName + "theory::uf::ee", true),
+      d_ownEqualityEngine(),
+      d_equalityEngine(initEqualityEngine(c, instanceName)),
       d_conflict(c, false),
       d_extensionality(u),
       d_uf_std_skolem(u),
       d_functionsTerms(c),
+      d_careIndexStamp(c),
+      d_careIndexLastStamp(0),
+      d_careIndexRebuilt(instanceName + "theory::uf::careGraphIndexRebuilt",
+                         0),
+      d_careIndexReused(instanceName + "theory::uf::careGraphIndexReused", 0),
       d_symb(u, instanceName)
 {
+  smtStatisticsRegistry()->registerStat(&d_careIndexRebuilt);
+  smtStatisticsRegistry()->registerStat(&d_careIndexReused);
+
   d_true = NodeManager::currentNM()->mkConst( true );
 
   // The kinds we are treating as function application in congruence
@@ -67,11 +77,34 @@ TheoryUF::TheoryUF(context::Context* c,
 }
 
 TheoryUF::~TheoryUF() {
+  smtStatisticsRegistry()->unregisterStat(&d_careIndexRebuilt);
+  smtStatisticsRegistry()->unregisterStat(&d_careIndexReused);
   delete d_thss;
 }
 
+eq::EqualityEngine& TheoryUF::initEqualityEngine(context::Context* c,
+                                                 std::string instanceName)
+{
+  eq::EqualityEngine* ee = nullptr;
+  if (options::eeCentral())
+  {
+    ee = d_valuation.getCentralEqualityEngine(THEORY_UF, &d_notify);
+  }
+  if (ee == nullptr)
+  {
+    d_ownEqualityEngine.reset(new eq::EqualityEngine(
+        d_notify, c, instanceName + "theory::uf::ee", true));
+    ee = d_ownEqualityEngine.get();
+  }
+  return *ee;
+}
+
 void TheoryUF::setMasterEqualityEngine(eq::EqualityEngine* eq) {
-  d_equalityEngine.setMasterEqualityEngine(eq);
+  // The central equality engine is connected by the theory engine
+  if (d_ownEqualityEngine)
+  {
+    d_equalityEngine.setMasterEqualityEngine(eq);
+  }
 }
 
 void TheoryUF::finishInit() {
@@ -312,6 +345,7 @@ void TheoryUF::preRegisterTerm(TNode node) {
     }
     // Remember the function and predicate terms
     d_functionsTerms.push_back(node);
+    touchCareIndex(getOperatorForApplyTerm(node));
     break;
   case kind::CARDINALITY_CONSTRAINT:
   case kind::COMBINED_CARDINALITY_CONSTRAINT:
@@ -587,6 +621,7 @@ EqualityStatus TheoryUF::getEqualityStatus(TNode a, TNode b) {
 void TheoryUF::addSharedTerm(TNode t) {
   Debug("uf::sharing") << "TheoryUF::addSharedTerm(" << t << ")" << std::endl;
   d_equalityEngine.addTriggerTerm(t, THEORY_UF);
+  touchCareIndexArg(d_equalityEngine.getRepresentative(t));
 }
 
 bool TheoryUF::areCareDisequal(TNode x, TNode y){
@@ -680,9 +715,121 @@ void TheoryUF::addCarePairs(TNodeTrie* t1,
   }
 }
 
+void TheoryUF::touchCareIndex(TNode op)
+{
+  if (options::ufIncrementalCareGraph())
+  {
+    d_careIndexStamp.insert(op, ++d_careIndexLastStamp);
+  }
+}
+
+void TheoryUF::touchCareIndexArg(TNode rep)
+{
+  if (!options::ufIncrementalCareGraph())
+  {
+    return;
+  }
+  std::unordered_map<Node,
+                     std::unordered_set<Node, NodeHashFunction>,
+                     NodeHashFunction>::const_iterator it =
+      d_careIndexArgOps.find(rep);
+  if (it != d_careIndexArgOps.end())
+  {
+    for (const Node& op : it->second)
+    {
+      touchCareIndex(op);
+    }
+  }
+}
+
+void TheoryUF::computeCareGraphIncremental()
+{
+  // Find the operators whose index is out of date
+  std::map<Node, bool> upToDate;
+  unsigned functionTerms = d_functionsTerms.size();
+  for (unsigned i = 0; i < functionTerms; ++i)
+  {
+    Node op = getOperatorForApplyTerm(d_functionsTerms[i]);
+    if (upToDate.find(op) != upToDate.end())
+    {
+      continue;
+    }
+    context::CDHashMap<Node, unsigned, NodeHashFunction>::const_iterator its =
+        d_careIndexStamp.find(op);
+    Assert(its != d_careIndexStamp.end());
+    std::map<Node, CareIndex>::iterator iti = d_careIndex.find(op);
+    bool current =
+        iti != d_careIndex.end() && iti->second.d_stamp == (*its).second;
+    upToDate[op] = current;
+    if (current)
+    {
+      ++d_careIndexReused;
+    }
+    else
+    {
+      ++d_careIndexRebuilt;
+      CareIndex& ci = d_careIndex[op];
+      ci.d_stamp = (*its).second;
+      ci.d_arity = 0;
+      ci.d_trie.clear();
+    }
+  }
+
+  // Rebuild them as computeCareGraph does, remembering the classes of the
+  // arguments
+  for (unsigned i = 0; i < functionTerms; ++i)
+  {
+    TNode f1 = d_functionsTerms[i];
+    Node op = getOperatorForApplyTerm(f1);
+    if (upToDate[op])
+    {
+      continue;
+    }
+    unsigned arg_start_index = getArgumentStartIndexForApplyTerm(f1);
+    std::vector<TNode> reps;
+    bool has_trigger_arg = false;
+    for (unsigned j = arg_start_index; j < f1.getNumChildren(); j++)
+    {
+      TNode r = d_equalityEngine.getRepresentative(f1[j]);
+      reps.push_back(r);
+      d_careIndexArgOps[r].insert(op);
+      if (d_equalityEngine.isTriggerTerm(f1[j], THEORY_UF))
+      {
+        has_trigger_arg = true;
+      }
+    }
+    if (has_trigger_arg)
+    {
+      CareIndex& ci = d_careIndex[op];
+      ci.d_trie.addTerm(f1, reps);
+      ci.d_arity = reps.size();
+    }
+  }
+
+  // The disequalities used to prune the search are not part of the index,
+  // they are always looked at
+  for (const std::pair<const Node, bool>& u : upToDate)
+  {
+    CareIndex& ci = d_careIndex[u.first];
+    if (!ci.d_trie.d_data.empty())
+    {
+      Debug("uf::sharing") << "TheoryUf::computeCareGraph(): Process index "
+                           << u.first << "..." << std::endl;
+      addCarePairs(&ci.d_trie, nullptr, ci.d_arity, 0);
+    }
+  }
+}
+
 void TheoryUF::computeCareGraph() {
 
-  if (d_sharedTerms.size() > 0) {
+  if (d_sharedTerms.size() > 0 && options::ufIncrementalCareGraph())
+  {
+    Debug("uf::sharing") << "TheoryUf::computeCareGraph(): incremental"
+                         << std::endl;
+    computeCareGraphIncremental();
+  }
+  else if (d_sharedTerms.size() > 0)
+  {
     //use term indexing
     Debug("uf::sharing") << "TheoryUf::computeCareGraph(): Build term indices..." << std::endl;
     std::map<Node, TNodeTrie> index;
@@ -732,6 +879,10 @@ void TheoryUF::eqNotifyNewClass(TNode t) {
 }
 
 void TheoryUF::eqNotifyPreMerge(TNode t1, TNode t2) {
+  // The terms with arguments in the class of t2 get new representatives,
+  // those in the class of t1 may get shared arguments
+  touchCareIndexArg(t1);
+  touchCareIndexArg(t2);
   //if (getLogicInfo().isQuantified()) {
     //getQuantifiersEngine()->getEfficientEMatcher()->merge( t1, t2 );
   //}
@@ -20,6 +20,12 @@
 #ifndef CVC4__THEORY__UF__THEORY_UF_H
 #define CVC4__THEORY__UF__THEORY_UF_H
 
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "context/cdhashmap.h"
 #include "context/cdhashset.h"
 #include "context/cdo.h"
 #include "expr/node.h"
@@ -27,6 +33,7 @@
 #include "theory/theory.h"
 #include "theory/uf/equality_engine.h"
 #include "theory/uf/symmetry_breaker.h"
+#include "util/statistics_registry.h"
 
 namespace CVC4 {
 namespace theory {
@@ -121,8 +128,15 @@ private:
   /** The associated theory strong solver (or NULL if none) */
   StrongSolverTheoryUF* d_thss;
 
+  /** Equality engine of this theory, null if the central one is used */
+  std::unique_ptr<eq::EqualityEngine> d_ownEqualityEngine;
+
   /** Equaltity engine */
-  eq::EqualityEngine d_equalityEngine;
+  eq::EqualityEngine& d_equalityEngine;
+
+  /** Get the central equality engine, or make our own */
+  eq::EqualityEngine& initEqualityEngine(context::Context* c,
+                                         std::string instanceName);
 
   /** Are we in conflict */
   context::CDO<bool> d_conflict;
@@ -162,6 +176,45 @@ private:
   /** All the function terms that the theory has seen */
   context::CDList<TNode> d_functionsTerms;
 
+  /**
+   * The care graph term index of an operator, kept from one care graph
+   * computation to the next (--uf-care-graph-incremental), with the stamp of
+   * the operator when it was built. Only the build of the index is
+   * incremental: the care pairs depend on the models of the other theories,
+   * so every index is searched again at each care graph computation.
+   */
+  struct CareIndex
+  {
+    CareIndex() : d_stamp(0), d_arity(0) {}
+    unsigned d_stamp;
+    unsigned d_arity;
+    TNodeTrie d_trie;
+  };
+  std::map<Node, CareIndex> d_careIndex;
+  /**
+   * The stamp of each operator, a fresh one whenever its index may change:
+   * new terms, merges of the classes of their arguments and new shared terms
+   * in these classes. The stamps pop with the equality engine, so an index
+   * whose stamp is current is up to date.
+   */
+  context::CDHashMap<Node, unsigned, NodeHashFunction> d_careIndexStamp;
+  /** The last stamp given to an operator */
+  unsigned d_careIndexLastStamp;
+  /**
+   * The operators with a term with an argument in the class of each
+   * representative, when their index was built. This is only ever extended,
+   * stale entries just cause extra rebuilds.
+   */
+  std::unordered_map<Node,
+                     std::unordered_set<Node, NodeHashFunction>,
+                     NodeHashFunction>
+      d_careIndexArgOps;
+
+  /** Number of care graph term indices rebuilt */
+  IntStat d_careIndexRebuilt;
+  /** Number of care graph term indices reused */
+  IntStat d_careIndexReused;
+
   /** Symmetry analyzer */
   SymmetryBreaker d_symb;
 
@@ -309,6 +362,12 @@ private:
                     TNodeTrie* t2,
                     unsigned arity,
                     unsigned depth);
+  /** Give op a fresh stamp, its care graph index is out of date */
+  void touchCareIndex(TNode op);
+  /** Touch the operators with terms with an argument in the class of rep */
+  void touchCareIndexArg(TNode rep);
+  /** Rebuild the out of date care graph indices, then search them all */
+  void computeCareGraphIncremental();
 };/* class TheoryUF */
 
 }/* CVC4::theory::uf namespace */
@@ -47,6 +47,8 @@ Region::Region(SortModel* cf, context::Context* c)
   , d_splitsSize( c, 0 )
   , d_testClique( c )
   , d_splits( c )
+  , d_splitList( c )
+  , d_splitListIndex( c, 0 )
   , d_reps_size( c, 0 )
   , d_total_diseq_external( c, 0 )
   , d_total_diseq_internal( c, 0 )
@@ -165,15 +167,8 @@ void Region::setDisequal( Node n1, Node n2, int type, bool valid ){
       d_total_diseq_internal = d_total_diseq_internal + ( valid ? 1 : -1 );
       if( valid ){
         //if they are both a part of testClique, then remove split
-        if( d_testClique.find( n1 )!=d_testClique.end() && d_testClique[n1] &&
-            d_testClique.find( n2 )!=d_testClique.end() && d_testClique[n2] ){
-          Node eq = NodeManager::currentNM()->mkNode( EQUAL, n1, n2 );
-          if( d_splits.find( eq )!=d_splits.end() && d_splits[ eq ] ){
-            Debug("uf-ss-debug") << "removing split for " << n1 << " " << n2
-                                 << std::endl;
-            d_splits[ eq ] = false;
-            d_splitsSize = d_splitsSize - 1;
-          }
+        if( inTestClique( n1 ) && inTestClique( n2 ) ){
+          removeSplit( n1, n2 );
         }
       }
     }
@@ -192,18 +187,60 @@ void Region::setRep( Node n, bool valid ) {
     Assert( !valid );
     d_testClique[n] = false;
     d_testCliqueSize = d_testCliqueSize - 1;
-    //remove all splits involving n
-    for( split_iterator it = begin_splits(); it != end_splits(); ++it ){
+    //remove all splits involving n, their other endpoints are the remaining
+    //members of the test clique
+    for( NodeBoolMap::iterator it = d_testClique.begin();
+         it != d_testClique.end(); ++it ){
       if( (*it).second ){
-        if( (*it).first[0]==n || (*it).first[1]==n ){
-          d_splits[ (*it).first ] = false;
-          d_splitsSize = d_splitsSize - 1;
-        }
+        removeSplit( n, (*it).first );
       }
     }
   }
 }
 
+StrongSolverTheoryUF::NodePair Region::mkSplitKey( Node n1, Node n2 ) {
+  return n1 < n2 ? NodePair( n1, n2 ) : NodePair( n2, n1 );
+}
+
+void Region::addSplit( Node n1, Node n2 ) {
+  NodePair key = mkSplitKey( n1, n2 );
+  Assert( d_splits.find( key )==d_splits.end() || !d_splits[ key ] );
+  d_splits[ key ] = true;
+  d_splitsSize = d_splitsSize + 1;
+  d_splitList.push_back( key );
+}
+
+void Region::removeSplit( Node n1, Node n2 ) {
+  NodePair key = mkSplitKey( n1, n2 );
+  NodePairBoolMap::const_iterator it = d_splits.find( key );
+  if( it!=d_splits.end() && (*it).second ){
+    Debug("uf-ss-debug") << "removing split for " << n1 << " " << n2
+                         << std::endl;
+    d_splits[ key ] = false;
+    d_splitsSize = d_splitsSize - 1;
+  }
+}
+
+bool Region::inTestClique( Node n ) {
+  NodeBoolMap::const_iterator it = d_testClique.find( n );
+  return it!=d_testClique.end() && (*it).second;
+}
+
+Node Region::getSplit() {
+  if( d_splitsSize==0 ){
+    return Node::null();
+  }
+  //splits are only ever removed in the current context, so the ones skipped
+  //here stay removed until the index is restored by a pop
+  unsigned i = d_splitListIndex;
+  while( !d_splits[ d_splitList[i] ] ){
+    ++i;
+    Assert( i<d_splitList.size() );
+  }
+  d_splitListIndex = i;
+  return d_splitList[i].first.eqNode( d_splitList[i].second );
+}
+
 bool Region::isDisequal( Node n1, Node n2, int type ) {
   RegionNodeInfo::DiseqList* del = d_nodes[ n1 ]->get(type);
   return del->isSet(n2) && del->getDisequalityValue(n2);
@@ -293,9 +330,7 @@ bool Region::check( Theory::Effort level, int cardinality,
         if( d_testCliqueSize<unsigned(cardinality) ){
           for( iterator it = begin(); it != end(); ++it ){
             //if not in the test clique, add it to the set of new members
-            if( it->second->valid() &&
-                ( d_testClique.find( it->first ) == d_testClique.end() ||
-                  !d_testClique[ it->first ] ) ){
+            if( it->second->valid() && !inTestClique( it->first ) ){
               //if( it->second->getNumInternalDisequalities()>cardinality ||
               //    level==Theory::EFFORT_FULL ){
               newClique.push_back( it->first );
@@ -315,9 +350,7 @@ bool Region::check( Theory::Effort level, int cardinality,
           for( std::map< Node, RegionNodeInfo* >::iterator
                  it = d_nodes.begin(); it != d_nodes.end(); ++it ){
             //if not in the test clique, add it to the set of new members
-            if( it->second->valid() &&
-                ( d_testClique.find( it->first )==d_testClique.end() ||
-                  !d_testClique[ it->first ] ) ){
+            if( it->second->valid() && !inTestClique( it->first ) ){
               if( it->second->getNumInternalDisequalities()>maxDeg ){
                 maxDeg = it->second->getNumInternalDisequalities();
                 maxNode = it->first;
@@ -333,12 +366,7 @@ bool Region::check( Theory::Effort level, int cardinality,
                                << newClique[j] << std::endl;
           for( int k=(j+1); k<(int)newClique.size(); k++ ){
             if( !isDisequal( newClique[j], newClique[k], 1 ) ){
-              Node at_j = newClique[j];
-              Node at_k = newClique[k];              
-              Node j_eq_k =
-                NodeManager::currentNM()->mkNode( EQUAL, at_j, at_k );
-              d_splits[ j_eq_k ] = true;
-              d_splitsSize = d_splitsSize + 1;
+              addSplit( newClique[j], newClique[k] );
             }
           }
           //check disequalities with old members
@@ -346,11 +374,7 @@ bool Region::check( Theory::Effort level, int cardinality,
                it != d_testClique.end(); ++it ){
             if( (*it).second ){
               if( !isDisequal( (*it).first, newClique[j], 1 ) ){
-                Node at_it = (*it).first;
-                Node at_j = newClique[j];
-                Node it_eq_j = at_it.eqNode(at_j);
-                d_splits[ it_eq_j ] = true;
-                d_splitsSize = d_splitsSize + 1;
+                addSplit( (*it).first, newClique[j] );
               }
             }
           }
@@ -430,10 +454,11 @@ void Region::debugPrint( const char* c, bool incClique ) {
     if( !d_splits.empty() ){
       Debug( c ) << "Required splits: " << std::endl;
       Debug( c ) << "   ";
-      for( NodeBoolMap::iterator it = d_splits.begin(); it != d_splits.end();
-           ++ it ){
+      for( NodePairBoolMap::iterator it = d_splits.begin();
+           it != d_splits.end(); ++ it ){
         if( (*it).second ){
-          Debug( c ) << (*it).first << " ";
+          Debug( c ) << "(" << (*it).first.first << " = "
+                     << (*it).first.second << ") ";
         }
       }
       Debug( c ) << ", size = " << d_splitsSize << std::endl;
@@ -984,18 +1009,8 @@ void SortModel::moveNode( Node n, int ri ){
 }
 
 int SortModel::addSplit( Region* r, OutputChannel* out ){
-  Node s;
-  if( r->hasSplits() ){
-    //take the first split you find
-    for( Region::split_iterator it = r->begin_splits();
-         it != r->end_splits(); ++it ){
-      if( (*it).second ){
-        s = (*it).first;
-        break;
-      }
-    }
-    Assert( s!=Node::null() );
-  }
+  //take the first split you find
+  Node s = r->getSplit();
   if (!s.isNull() ){
     //add lemma to output channel
     Assert( s.getKind()==EQUAL );
@@ -18,9 +18,11 @@
 #define CVC4__THEORY_UF_STRONG_SOLVER_H
 
 #include "context/cdhashmap.h"
+#include "context/cdlist.h"
 #include "context/context.h"
 #include "context/context_mm.h"
 #include "theory/theory.h"
+#include "util/hash.h"
 #include "util/statistics_registry.h"
 
 #include "theory/decision_manager.h"
@@ -44,6 +46,12 @@ protected:
   typedef context::CDHashMap<Node, int, NodeHashFunction> NodeIntMap;
   typedef context::CDHashMap<Node, Node, NodeHashFunction> NodeNodeMap;
   typedef context::CDHashMap<TypeNode, bool, TypeNodeHashFunction> TypeNodeBoolMap;
+  typedef std::pair<Node, Node> NodePair;
+  typedef context::CDHashMap<
+      NodePair,
+      bool,
+      PairHashFunction<Node, Node, NodeHashFunction, NodeHashFunction>>
+      NodePairBoolMap;
 public:
   /**
    * Information for incremental conflict/clique finding for a
@@ -134,8 +142,24 @@ public:
       context::CDO< unsigned > d_splitsSize;
       //a postulated clique
       NodeBoolMap d_testClique;
-      //disequalities needed for this clique to happen
-      NodeBoolMap d_splits;
+      /**
+       * Disequalities needed for this clique to happen, keyed by the
+       * (ordered) pair of test clique members, so no equality node has to
+       * be built until the split is actually sent.
+       */
+      NodePairBoolMap d_splits;
+      /** the splits in the order they were required (may contain stale ones) */
+      context::CDList<NodePair> d_splitList;
+      /** all splits before this index in d_splitList are no longer required */
+      context::CDO<unsigned> d_splitListIndex;
+      /** the key of the split between n1 and n2 */
+      static NodePair mkSplitKey(Node n1, Node n2);
+      /** require the split between n1 and n2 */
+      void addSplit(Node n1, Node n2);
+      /** the split between n1 and n2 is no longer required */
+      void removeSplit(Node n1, Node n2);
+      /** is n a member of the test clique? */
+      bool inTestClique(Node n);
       //number of valid representatives in this region
       context::CDO< unsigned > d_reps_size;
       //total disequality size (external)
@@ -158,10 +182,6 @@ public:
       iterator begin() { return d_nodes.begin(); }
       iterator end() { return d_nodes.end(); }
 
-      typedef NodeBoolMap::iterator split_iterator;
-      split_iterator begin_splits() { return d_splits.begin(); }
-      split_iterator end_splits() { return d_splits.end(); }
-
       /** Returns a RegionInfo. */
       RegionNodeInfo* getRegionInfo(Node n) {
         Assert(d_nodes.find(n) != d_nodes.end());
@@ -190,7 +210,8 @@ public:
       int getTestCliqueSize() { return d_testCliqueSize; }
       // has representative
       bool hasRep( Node n ) {
-        return d_nodes.find(n) != d_nodes.end() && d_nodes[n]->valid();
+        std::map< Node, RegionNodeInfo* >::const_iterator it = d_nodes.find(n);
+        return it != d_nodes.end() && it->second->valid();
       }
       // is disequal
       bool isDisequal( Node n1, Node n2, int type );
@@ -198,6 +219,11 @@ public:
       bool getMustCombine( int cardinality );
       /** has splits */
       bool hasSplits() { return d_splitsSize>0; }
+      /**
+       * Get the first required split, as the equality between its endpoints,
+       * or the null node if there are none.
+       */
+      Node getSplit();
       /** get external disequalities */
       void getNumExternalDisequalities(std::map< Node, int >& num_ext_disequalities );
       /** check for cliques */
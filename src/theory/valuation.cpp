@@ -111,6 +111,16 @@ TheoryModel* Valuation::getModel() {
   return d_engine->getModel();
 }
 
+eq::EqualityEngine* Valuation::getCentralEqualityEngine(
+    TheoryId theory, eq::EqualityEngineNotify* notify)
+{
+  if (d_engine == nullptr)
+  {
+    return nullptr;
+  }
+  return d_engine->getCentralEqualityEngine(theory, notify);
+}
+
 Node Valuation::ensureLiteral(TNode n) {
   return d_engine->ensureLiteral(n);
 }
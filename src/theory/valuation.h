@@ -34,6 +34,11 @@ class EntailmentCheckParameters;
 class EntailmentCheckSideEffects;
 class TheoryModel;
 
+namespace eq {
+class EqualityEngine;
+class EqualityEngineNotify;
+}  // namespace eq
+
 /**
  * The status of an equality in the current context.
  */
@@ -112,6 +117,14 @@ public:
    * Returns pointer to model.
    */
   TheoryModel* getModel();
+
+  /**
+   * Returns the equality engine shared by the theories (--ee-central), after
+   * registering the notification class of the given theory with it. Returns
+   * null if the theories have their own equality engines.
+   */
+  eq::EqualityEngine* getCentralEqualityEngine(
+      TheoryId theory, eq::EqualityEngineNotify* notify);
   
   /**
    * Ensure that the given node will have a designated SAT literal
@@ -336,6 +336,12 @@ public:
     return (*this);
   }
 
+  /** this += a * b. */
+  Rational& addProduct(const Rational& a, const Rational& b){
+    d_value += a.d_value * b.d_value;
+    return (*this);
+  }
+
   /** Returns a string representing the rational in the given base. */
   std::string toString(int base = 10) const {
     cln::cl_print_flags flags;
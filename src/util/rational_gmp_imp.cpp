@@ -15,7 +15,9 @@
  **/
 #include "util/rational.h"
 
+#include <climits>
 #include <cmath>
+#include <cstdlib>
 #include <sstream>
 #include <string>
 
@@ -86,6 +88,69 @@ int Rational::absCmp(const Rational& q) const{
 }
 
 
+namespace {
+
+/**
+ * Get q as num / den if both fit in a long. The minimal long is rejected, so
+ * that the absolute values fit as well.
+ */
+bool getSmall(const mpq_class& q, long& num, long& den)
+{
+  if (!mpz_fits_slong_p(q.get_num_mpz_t())
+      || !mpz_fits_slong_p(q.get_den_mpz_t()))
+  {
+    return false;
+  }
+  num = mpz_get_si(q.get_num_mpz_t());
+  den = mpz_get_si(q.get_den_mpz_t());
+  return num != LONG_MIN;
+}
+
+/** Greatest common divisor of a >= 0 and b > 0. */
+long gcd(long a, long b)
+{
+  while (a != 0)
+  {
+    long r = b % a;
+    b = a;
+    a = r;
+  }
+  return b;
+}
+
+}  // namespace
+
+Rational& Rational::addProduct(const Rational& a, const Rational& b)
+{
+  long an, ad, bn, bd, cn, cd;
+  if (getSmall(a.d_value, an, ad) && getSmall(b.d_value, bn, bd)
+      && getSmall(d_value, cn, cd))
+  {
+    // a * b = pn / pd, cancelled crosswise to keep the values small
+    long g1 = gcd(std::labs(an), bd);
+    long g2 = gcd(std::labs(bn), ad);
+    long pn, pd;
+    if (!__builtin_mul_overflow(an / g1, bn / g2, &pn)
+        && !__builtin_mul_overflow(ad / g2, bd / g1, &pd))
+    {
+      // cn / cd + pn / pd = (cn * (pd / g) + pn * (cd / g)) / (cd * (pd / g))
+      long g = gcd(cd, pd);
+      long t1, t2, rn, rd;
+      if (!__builtin_mul_overflow(cn, pd / g, &t1)
+          && !__builtin_mul_overflow(pn, cd / g, &t2)
+          && !__builtin_add_overflow(t1, t2, &rn)
+          && !__builtin_mul_overflow(cd, pd / g, &rd) && rn != LONG_MIN)
+      {
+        long h = gcd(std::labs(rn), rd);
+        mpq_set_si(d_value.get_mpq_t(), rn / h, rd / h);
+        return *this;
+      }
+    }
+  }
+  d_value += a.d_value * b.d_value;
+  return *this;
+}
+
 /** Return an exact rational for a double d. */
 Maybe<Rational> Rational::fromDouble(double d)
 {
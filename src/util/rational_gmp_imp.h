@@ -317,6 +317,12 @@ public:
     return (*this);
   }
 
+  /**
+   * this += a * b. When all the numerators and denominators fit in a
+   * machine word, and so does the result, this is computed without GMP.
+   */
+  Rational& addProduct(const Rational& a, const Rational& b);
+
   bool isIntegral() const{
     return getDenominator() == 1;
   }
@@ -0,0 +1,20 @@
+; COMMAND-LINE: --incremental --bound-flips
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_LRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(assert (and (<= 0 x) (<= x 1)))
+(assert (and (<= 0 y) (<= y 1)))
+(assert (and (<= 0 z) (<= z 1)))
+(assert (>= (+ x y z) 2))
+(assert (<= (- x y) (/ 1 2)))
+(check-sat)
+(push 1)
+(assert (>= (+ x y (* 2 z)) (/ 15 4)))
+(assert (<= (+ x y) (/ 3 2)))
+(check-sat)
+(pop 1)
+(check-sat)
@@ -0,0 +1,19 @@
+; COMMAND-LINE: --incremental --float-relax --heuristic-pivots=0 --standard-effort-variable-order-pivots=0
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_LRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(assert (>= (+ x y) 2))
+(assert (<= (- x y) 1))
+(assert (<= (+ (* 2 x) (* 3 y)) 12))
+(assert (>= (+ x (* 2 y)) 3))
+(assert (>= x 0))
+(assert (>= y 0))
+(check-sat)
+(push 1)
+(assert (> (+ x y) 6))
+(check-sat)
+(pop 1)
+(check-sat)
@@ -0,0 +1,20 @@
+; COMMAND-LINE: --incremental --cube-test
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (>= x 0))
+(assert (>= y 0))
+(assert (>= (+ (* 3 x) (* 2 y)) 17))
+(assert (<= (- (* 2 x) (* 3 y)) 5))
+(assert (<= (+ (* 3 x) (* 7 y) z) 1000))
+(assert (>= (- z x) 3))
+(check-sat)
+(push 1)
+(assert (<= (+ (* 3 x) (* 2 y)) 16))
+(check-sat)
+(pop 1)
+(check-sat)
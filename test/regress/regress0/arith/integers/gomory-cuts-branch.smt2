@@ -0,0 +1,17 @@
+; COMMAND-LINE: --incremental --gomory-cuts --no-dio-solver
+; COMMAND-LINE: --incremental --gomory-cuts --no-dio-solver --maxCutsInContext=2
+; EXPECT: unsat
+; EXPECT: sat
+; Without the Diophantine solver, the cuts alone do not settle these
+; queries; branching has to take over.
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (= (- (* 5 x) (* 3 y)) 1))
+(assert (>= (+ x y) 10))
+(push 1)
+(assert (<= (+ x y) 12))
+(check-sat)
+(pop 1)
+(assert (<= (+ x y) 13))
+(check-sat)
@@ -0,0 +1,17 @@
+; COMMAND-LINE: --incremental --gomory-cuts
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (>= x 0))
+(assert (>= y 0))
+(assert (<= (+ (* 2 x) (* 4 y)) 7))
+(assert (>= (+ (* 3 x) y) 5))
+(check-sat)
+(push 1)
+(assert (>= (+ (* 2 x) (* 4 y)) 7))
+(check-sat)
+(pop 1)
+(check-sat)
@@ -0,0 +1,14 @@
+; COMMAND-LINE: --arith-prop-budget=2
+; EXPECT: unsat
+(set-logic QF_LRA)
+(set-info :status unsat)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(assert (<= (+ x y) 4.0))
+(assert (<= (+ y z) 3.0))
+(assert (>= x 1.0))
+(assert (>= y 1.0))
+(assert (>= z 1.0))
+(assert (or (> (+ x y z) 6.0) (> (- x z) 3.0)))
+(check-sat)
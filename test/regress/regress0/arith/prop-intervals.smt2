@@ -0,0 +1,16 @@
+; COMMAND-LINE: --theory-prop-intervals=arith:4,bv:2
+; EXPECT: unsat
+(set-logic QF_LRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(declare-fun p () Bool)
+(assert (or p (< x y)))
+(assert (or (not p) (< y x)))
+(assert (< y z))
+(assert (< z (+ x 1)))
+(assert (or (and p (>= (- x y) 2)) (and (not p) (>= (- y x) 2))))
+(assert (or (> z (+ y 3)) (< (+ x z) (* 2 y))))
+(assert (<= x 0))
+(assert (>= y 0))
+(check-sat)
@@ -0,0 +1,20 @@
+; COMMAND-LINE: --incremental --ee-central
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_AUF)
+(declare-sort U 0)
+(declare-sort I 0)
+(declare-fun f (U) U)
+(declare-fun a () (Array I U))
+(declare-fun b () (Array I U))
+(declare-fun i () I)
+(declare-fun j () I)
+(declare-fun x () U)
+(assert (= a (store b i x)))
+(push 1)
+(assert (= i j))
+(assert (not (= (f (select a j)) (f x))))
+(check-sat)
+(pop 1)
+(assert (not (= (f (select a j)) (f (select b j)))))
+(check-sat)
@@ -0,0 +1,13 @@
+; COMMAND-LINE: --model-based-tc
+; EXPECT: sat
+(set-logic QF_AUFLIA)
+(declare-fun a () (Array Int Int))
+(declare-fun i () Int)
+(declare-fun j () Int)
+(declare-fun k () Int)
+(assert (< i j))
+(assert (< j k))
+(assert (= (select a i) (+ (select a j) 1)))
+(assert (= (select a j) (+ (select a k) 1)))
+(assert (= (select (store a j 5) k) 3))
+(check-sat)
@@ -0,0 +1,10 @@
+; COMMAND-LINE: --model-based-tc
+; EXPECT: unsat
+(set-logic QF_AUFLIA)
+(declare-fun a () (Array Int Int))
+(declare-fun i () Int)
+(declare-fun j () Int)
+(assert (<= i j))
+(assert (<= j i))
+(assert (= (select (store a i 1) j) 0))
+(check-sat)
@@ -0,0 +1,9 @@
+; COMMAND-LINE: --model-based-tc
+; EXPECT: unsat
+(set-logic QF_ABV)
+(declare-fun a () (Array (_ BitVec 1) (_ BitVec 2)))
+(declare-fun i () (_ BitVec 1))
+(declare-fun j () (_ BitVec 1))
+(declare-fun k () (_ BitVec 1))
+(assert (distinct (select a i) (select a j) (select a k)))
+(check-sat)
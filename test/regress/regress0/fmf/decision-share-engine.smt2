@@ -0,0 +1,15 @@
+; COMMAND-LINE: --finite-model-find --decision=justification --decision-share-engine=1
+; COMMAND-LINE: --finite-model-find --decision=justification --decision-share-engine=2 --decision-share-activity=1
+; EXPECT: sat
+; The decision engine is asked before the theories, the cardinality splits
+; must still be decided before the search stops.
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(declare-fun f (U) U)
+(assert (distinct a b c))
+(assert (forall ((x U)) (not (= (f x) x))))
+(assert (forall ((x U) (y U) (z U) (w U)) (or (= x y) (= x z) (= x w) (= y z) (= y w) (= z w))))
+(check-sat)
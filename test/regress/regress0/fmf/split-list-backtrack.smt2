@@ -0,0 +1,32 @@
+; COMMAND-LINE: --finite-model-find --incremental
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(declare-fun d () U)
+(declare-fun e () U)
+(declare-fun f (U) U)
+(declare-fun p (U) Bool)
+(assert (distinct a b c))
+(assert (p (f a)))
+(assert (not (p (f b))))
+(assert (or (= (f c) a) (= (f c) b) (= (f c) d)))
+(check-sat)
+(push 1)
+(assert (or (= d e) (= (f d) e)))
+(assert (not (p e)))
+(assert (or (= e (f a)) (= e (f c))))
+(check-sat)
+(push 1)
+(assert (p (f c)))
+(assert (or (= (f c) (f b)) (= (f a) (f b))))
+(check-sat)
+(pop 1)
+(assert (= d (f e)))
+(check-sat)
+(pop 1)
@@ -0,0 +1,13 @@
+; COMMAND-LINE: --arith-icp
+; EXPECT: unsat
+(set-logic QF_NRA)
+(set-info :status unsat)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(assert (>= x 2.0))
+(assert (>= y 3.0))
+(assert (<= (* x y) 12.0))
+(assert (or (> y 6.0) (< (* x y z) 5.0)))
+(assert (>= z 1.0))
+(check-sat)
@@ -0,0 +1,9 @@
+; COMMAND-LINE: --nl-ext --nl-ext-cover
+; EXPECT: unsat
+(set-logic QF_NIA)
+(set-info :status unsat)
+(declare-fun x () Int)
+(assert (> (* x x x) 2))
+(assert (< (- (* x x) (* 3 x)) (- 2)))
+(assert (or (< x 1) (> x 1)))
+(check-sat)
@@ -0,0 +1,9 @@
+; COMMAND-LINE: --nl-ext --nl-ext-cover
+; EXPECT: unsat
+(set-logic QF_NRA)
+(set-info :status unsat)
+(declare-fun x () Real)
+(assert (> (* x x x) 2.0))
+(assert (< (- (* x x) (* 3.0 x)) (- 2.0)))
+(assert (or (< x 1.2) (> x 2.5)))
+(check-sat)
@@ -0,0 +1,12 @@
+; COMMAND-LINE: --nl-ext --nl-ext-work-limit=1
+; EXPECT: unsat
+(set-logic QF_NRA)
+(set-info :status unsat)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(assert (> x 1))
+(assert (> y 1))
+(assert (> z 1))
+(assert (or (< (* x y z) (* x y)) (< (* y z) y) (< (* x z) z)))
+(check-sat)
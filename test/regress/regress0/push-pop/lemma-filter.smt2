@@ -0,0 +1,18 @@
+; COMMAND-LINE: --incremental --lemma-filter
+; EXPECT: unsat
+; EXPECT: unsat
+; EXPECT: unsat
+(set-logic UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun a () Int)
+(assert (forall ((x Int)) (> (f x) x)))
+(push 1)
+(assert (< (f a) a))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (< (f (+ a 1)) a))
+(check-sat)
+(pop 1)
+(assert (< (f a) (+ a 1)))
+(check-sat)
@@ -0,0 +1,20 @@
+; COMMAND-LINE: --sat-xor --incremental
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_UF)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+(declare-fun c () Bool)
+(declare-fun d () Bool)
+(declare-fun e () Bool)
+(assert (xor a (xor b (xor c d))))
+(check-sat)
+(push 1)
+; a + b + e = 0 and c + d + e = 0 sum up to a + b + c + d = 0
+(assert (not (xor a (xor b e))))
+(assert (not (xor c (xor d e))))
+(check-sat)
+(pop 1)
+(assert (or a e))
+(check-sat)
@@ -0,0 +1,27 @@
+; COMMAND-LINE: --incremental --ee-explain-cache --ee-explain-shortcuts
+; EXPECT: unsat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(declare-fun d () U)
+(declare-fun p () Bool)
+(assert (= a b))
+(assert (= b c))
+(assert (= c d))
+(push 1)
+(assert (= a d))
+(assert (or p (not (= (f a) (f d)))))
+(assert (or (not p) (not (= (f (f a)) (f (f d))))))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (not (= (f b) (f d))))
+(check-sat)
+(pop 1)
+(assert (not (= (f a) a)))
+(check-sat)
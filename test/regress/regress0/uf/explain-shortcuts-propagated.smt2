@@ -0,0 +1,32 @@
+; COMMAND-LINE: --incremental --ee-explain-shortcuts
+; COMMAND-LINE: --incremental --ee-explain-shortcuts --ee-explain-cache
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; The equalities (= a c) and (= (f a) (f c)) are propagated by the equality
+; engine and then asserted back to it. Their explanations must not use the
+; equalities asserted back, which came later.
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(declare-fun d () U)
+(declare-fun q () Bool)
+(declare-fun r () Bool)
+(assert (= a b))
+(assert (= b c))
+(push 1)
+(assert (=> (= (f a) (f c)) q))
+(assert (=> (= a c) (not q)))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (or (= a c) r))
+(assert (or (= (f a) (f c)) (not r)))
+(assert (=> (= (f (f a)) (f (f c))) (= c d)))
+(check-sat)
+(assert (not (= d a)))
+(check-sat)
+(pop 1)
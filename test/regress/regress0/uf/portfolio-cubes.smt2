@@ -0,0 +1,28 @@
+; COMMAND-LINE: --incremental --incremental-parallel --threads=2 --cube-depth=2
+; COMMAND-LINE: --incremental --incremental-parallel --threads=3 --cube-depth=3 --filter-lemma-length=10
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(declare-fun p () Bool)
+(declare-fun q () Bool)
+(declare-fun r () Bool)
+(assert (or p (= a b)))
+(assert (or q (= b c)))
+(assert (or r (not (= (f a) (f c)))))
+(check-sat)
+(push 1)
+(assert (not p))
+(assert (not q))
+(check-sat)
+(assert (not r))
+(check-sat)
+(pop 1)
+(assert (= (f a) a))
+(check-sat)
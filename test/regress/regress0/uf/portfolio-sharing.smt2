@@ -0,0 +1,22 @@
+; COMMAND-LINE: --threads=2 --filter-lemma-length=10
+; COMMAND-LINE: --threads=2 --filter-lemma-length=-1
+; EXPECT: unsat
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun p0 () U)
+(declare-fun p1 () U)
+(declare-fun p2 () U)
+(declare-fun p3 () U)
+(declare-fun p4 () U)
+(declare-fun h0 () U)
+(declare-fun h1 () U)
+(declare-fun h2 () U)
+(declare-fun h3 () U)
+(assert (or (= (f p0) h0) (= (f p0) h1) (= (f p0) h2) (= (f p0) h3)))
+(assert (or (= (f p1) h0) (= (f p1) h1) (= (f p1) h2) (= (f p1) h3)))
+(assert (or (= (f p2) h0) (= (f p2) h1) (= (f p2) h2) (= (f p2) h3)))
+(assert (or (= (f p3) h0) (= (f p3) h1) (= (f p3) h2) (= (f p3) h3)))
+(assert (or (= (f p4) h0) (= (f p4) h1) (= (f p4) h2) (= (f p4) h3)))
+(assert (distinct (f p0) (f p1) (f p2) (f p3) (f p4)))
+(check-sat)
@@ -0,0 +1,30 @@
+; COMMAND-LINE: --incremental --uf-care-graph-incremental
+; COMMAND-LINE: --incremental
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun g (Int Int) Int)
+(declare-fun h (Int) Bool)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (h (f x)))
+(assert (not (h (f y))))
+(assert (<= (g x z) (g y z)))
+(push 1)
+(assert (<= x y))
+(assert (<= y x))
+(check-sat)
+(pop 1)
+(assert (<= x z))
+(check-sat)
+(push 1)
+(assert (<= z y))
+(assert (<= y x))
+(check-sat)
+(pop 1)
+(assert (< (g x z) (g y z)))
+(check-sat)
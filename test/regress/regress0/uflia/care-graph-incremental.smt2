@@ -0,0 +1,18 @@
+; COMMAND-LINE: --incremental --uf-care-graph-incremental
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_UFLIA)
+(declare-fun f (Int Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (not (= (f x z) (f y z))))
+(assert (<= x y))
+(check-sat)
+(push 1)
+(assert (<= y x))
+(check-sat)
+(pop 1)
+(assert (<= (+ x 1) y))
+(check-sat)
@@ -0,0 +1,19 @@
+; COMMAND-LINE: --incremental --theory-check-cutoff
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (= (* 2 x) (+ (* 3 y) 1)))
+(assert (not (= (f x) (f y))))
+(assert (< 0 x 10))
+(check-sat)
+(push 1)
+(assert (< x 3))
+(assert (= (f 2) (f 1)))
+(check-sat)
+(pop 1)
+(assert (> (f x) (f y)))
+(check-sat)
@@ -0,0 +1,65 @@
+/*********************                                                        */
+/*! \file decision_scheduler_white.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of CVC4::prop::DecisionScheduler
+ **
+ ** White box testing of CVC4::prop::DecisionScheduler.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include "prop/decision_scheduler.h"
+
+using namespace CVC4;
+using namespace CVC4::prop;
+
+class DecisionSchedulerWhite : public CxxTest::TestSuite
+{
+ public:
+  void testDisabled()
+  {
+    DecisionScheduler sched;
+    TS_ASSERT(!sched.enabled());
+    DecisionScheduler::Source order[DecisionScheduler::NUM_SOURCES];
+    sched.nextOrder(order);
+    TS_ASSERT_EQUALS(order[0], DecisionScheduler::THEORY);
+    TS_ASSERT_EQUALS(order[1], DecisionScheduler::ENGINE);
+    TS_ASSERT_EQUALS(order[2], DecisionScheduler::ACTIVITY);
+  }
+
+  void testWeights()
+  {
+    DecisionScheduler sched;
+    sched.setWeight(DecisionScheduler::ENGINE, 1);
+    sched.setWeight(DecisionScheduler::ACTIVITY, 3);
+    TS_ASSERT(sched.enabled());
+    unsigned first[DecisionScheduler::NUM_SOURCES] = {0, 0, 0};
+    DecisionScheduler::Source order[DecisionScheduler::NUM_SOURCES];
+    for (unsigned i = 0; i < 400; ++i)
+    {
+      sched.nextOrder(order);
+      first[order[0]]++;
+      // The other sources follow in the default order
+      if (order[0] == DecisionScheduler::ACTIVITY)
+      {
+        TS_ASSERT_EQUALS(order[1], DecisionScheduler::THEORY);
+        TS_ASSERT_EQUALS(order[2], DecisionScheduler::ENGINE);
+      }
+      else
+      {
+        TS_ASSERT_EQUALS(order[0], DecisionScheduler::ENGINE);
+        TS_ASSERT_EQUALS(order[1], DecisionScheduler::THEORY);
+        TS_ASSERT_EQUALS(order[2], DecisionScheduler::ACTIVITY);
+      }
+    }
+    TS_ASSERT_EQUALS(first[DecisionScheduler::THEORY], 0u);
+    TS_ASSERT_EQUALS(first[DecisionScheduler::ENGINE], 100u);
+    TS_ASSERT_EQUALS(first[DecisionScheduler::ACTIVITY], 300u);
+  }
+};
@@ -0,0 +1,219 @@
+/*********************                                                        */
+/*! \file minisat_xor_white.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of the native XOR constraints of MiniSat
+ **
+ ** White box testing of the native XOR constraints of MiniSat: propagation,
+ ** conflicts, explanations, user level pops and Gauss-Jordan elimination.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include "context/context.h"
+#include "expr/expr_manager.h"
+#include "prop/minisat/core/Solver.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+
+using namespace CVC4;
+using namespace CVC4::smt;
+using namespace Minisat;
+
+class MinisatXorWhite : public CxxTest::TestSuite
+{
+  ExprManager* d_exprManager;
+  SmtEngine* d_smt;
+  SmtScope* d_scope;
+  context::Context* d_context;
+  Solver* d_solver;
+
+  /** Adds the constraint x xor y xor z = rhs. */
+  void addXor(Var x, Var y, Var z, bool rhs)
+  {
+    vec<Var> vs;
+    vs.push(x);
+    vs.push(y);
+    vs.push(z);
+    TS_ASSERT(d_solver->addXorClause(vs, rhs));
+  }
+
+  /** Does the clause contain the literal? */
+  bool contains(CRef cr, Lit l)
+  {
+    const Clause& c = d_solver->ca[cr];
+    for (int i = 0; i < c.size(); ++i)
+    {
+      if (c[i] == l)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ public:
+  void setUp() override
+  {
+    d_exprManager = new ExprManager();
+    d_smt = new SmtEngine(d_exprManager);
+    d_scope = new SmtScope(d_smt);
+    d_context = new context::Context();
+    // No theory atoms are used, so there is no need for a theory proxy
+    d_solver = new Solver(nullptr, d_context, true);
+  }
+
+  void tearDown() override
+  {
+    delete d_solver;
+    delete d_context;
+    delete d_scope;
+    delete d_smt;
+    delete d_exprManager;
+  }
+
+  void testPropagation()
+  {
+    Var a = d_solver->newVar();
+    Var b = d_solver->newVar();
+    Var c = d_solver->newVar();
+    addXor(a, b, c, true);
+
+    d_solver->newDecisionLevel();
+    d_solver->uncheckedEnqueue(mkLit(a, false));
+    TS_ASSERT_EQUALS(d_solver->propagate(Solver::CHECK_WITHOUT_THEORY),
+                     CRef_Undef);
+    TS_ASSERT(d_solver->value(c) == l_Undef);
+
+    // a = b = 1 implies c = 1, explained by c or not a or not b
+    d_solver->newDecisionLevel();
+    d_solver->uncheckedEnqueue(mkLit(b, false));
+    TS_ASSERT_EQUALS(d_solver->propagate(Solver::CHECK_WITHOUT_THEORY),
+                     CRef_Undef);
+    TS_ASSERT(d_solver->value(c) == l_True);
+    TS_ASSERT_EQUALS(d_solver->level(c), 2);
+    CRef cr = d_solver->reason(c);
+    TS_ASSERT_EQUALS(d_solver->ca[cr].size(), 3);
+    TS_ASSERT_EQUALS(d_solver->ca[cr][0], mkLit(c, false));
+    TS_ASSERT(contains(cr, mkLit(a, true)));
+    TS_ASSERT(contains(cr, mkLit(b, true)));
+
+    // The same propagation reuses the reason clause
+    d_solver->cancelUntil(1);
+    TS_ASSERT(d_solver->value(c) == l_Undef);
+    d_solver->newDecisionLevel();
+    d_solver->uncheckedEnqueue(mkLit(b, false));
+    TS_ASSERT_EQUALS(d_solver->propagate(Solver::CHECK_WITHOUT_THEORY),
+                     CRef_Undef);
+    TS_ASSERT_EQUALS(d_solver->reason(c), cr);
+
+    // A different one does not
+    d_solver->cancelUntil(1);
+    d_solver->newDecisionLevel();
+    d_solver->uncheckedEnqueue(mkLit(b, true));
+    TS_ASSERT_EQUALS(d_solver->propagate(Solver::CHECK_WITHOUT_THEORY),
+                     CRef_Undef);
+    TS_ASSERT(d_solver->value(c) == l_False);
+    CRef cr2 = d_solver->reason(c);
+    TS_ASSERT_DIFFERS(cr2, cr);
+    TS_ASSERT_EQUALS(d_solver->ca[cr2][0], mkLit(c, true));
+    TS_ASSERT(contains(cr2, mkLit(b, false)));
+  }
+
+  void testConflict()
+  {
+    Var a = d_solver->newVar();
+    Var b = d_solver->newVar();
+    Var c = d_solver->newVar();
+    addXor(a, b, c, false);
+
+    d_solver->newDecisionLevel();
+    d_solver->uncheckedEnqueue(mkLit(a, false));
+    d_solver->uncheckedEnqueue(mkLit(b, false));
+    d_solver->uncheckedEnqueue(mkLit(c, false));
+    CRef confl = d_solver->propagate(Solver::CHECK_WITHOUT_THEORY);
+    TS_ASSERT_DIFFERS(confl, CRef_Undef);
+    const Clause& cl = d_solver->ca[confl];
+    TS_ASSERT_EQUALS(cl.size(), 3);
+    for (int i = 0; i < cl.size(); ++i)
+    {
+      TS_ASSERT(d_solver->value(cl[i]) == l_False);
+    }
+  }
+
+  void testPopKeepsReasons()
+  {
+    Var a = d_solver->newVar();
+    Var b = d_solver->newVar();
+    Var c = d_solver->newVar();
+    addXor(a, b, c, true);
+    d_solver->uncheckedEnqueue(mkLit(a, false));
+    d_solver->uncheckedEnqueue(mkLit(b, false));
+    TS_ASSERT_EQUALS(d_solver->propagate(Solver::CHECK_WITHOUT_THEORY),
+                     CRef_Undef);
+    TS_ASSERT(d_solver->value(c) == l_True);
+
+    // A constraint above the user level is removed on pop, the propagation
+    // of c stays and is still explained by its constraint
+    d_solver->push();
+    Var d = d_solver->newVar();
+    Var e = d_solver->newVar();
+    Var f = d_solver->newVar();
+    addXor(d, e, f, false);
+    addXor(a, d, e, false);
+    TS_ASSERT_EQUALS(d_solver->xors.size(), 3u);
+    d_solver->pop();
+    TS_ASSERT_EQUALS(d_solver->xors.size(), 1u);
+
+    TS_ASSERT(d_solver->value(c) == l_True);
+    CRef cr = d_solver->reason(c);
+    TS_ASSERT_DIFFERS(cr, CRef_Undef);
+    TS_ASSERT_EQUALS(d_solver->ca[cr][0], mkLit(c, false));
+  }
+
+  void testGaussUnits()
+  {
+    Var a = d_solver->newVar();
+    Var b = d_solver->newVar();
+    Var c = d_solver->newVar();
+    Var d = d_solver->newVar();
+    addXor(a, b, c, true);
+    addXor(b, c, d, false);
+    d_solver->uncheckedEnqueue(mkLit(a, false));
+    TS_ASSERT_EQUALS(d_solver->propagate(Solver::CHECK_WITHOUT_THEORY),
+                     CRef_Undef);
+    TS_ASSERT(d_solver->value(d) == l_Undef);
+
+    // The sum of the constraints is a + d = 1, so d = 0 because of a
+    TS_ASSERT(d_solver->simplify());
+    TS_ASSERT(d_solver->value(d) == l_False);
+    CRef cr = d_solver->reason(d);
+    TS_ASSERT_DIFFERS(cr, CRef_Undef);
+    TS_ASSERT_EQUALS(d_solver->ca[cr].size(), 2);
+    TS_ASSERT_EQUALS(d_solver->ca[cr][0], mkLit(d, true));
+    TS_ASSERT(contains(cr, mkLit(a, true)));
+  }
+
+  void testGaussConflict()
+  {
+    Var a = d_solver->newVar();
+    Var b = d_solver->newVar();
+    Var c = d_solver->newVar();
+    Var d = d_solver->newVar();
+    addXor(a, b, c, true);
+    addXor(a, c, d, false);
+    addXor(b, c, d, false);
+    // The sum of the three constraints is c = 1
+    TS_ASSERT(d_solver->simplify());
+    TS_ASSERT(d_solver->value(c) == l_True);
+
+    // b + c + d = 1 contradicts the third constraint
+    addXor(b, c, d, true);
+    TS_ASSERT(!d_solver->simplify());
+  }
+};
@@ -0,0 +1,76 @@
+/*********************                                                        */
+/*! \file sat_local_search_white.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of CVC4::prop::SatLocalSearch
+ **
+ ** White box testing of CVC4::prop::SatLocalSearch.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <vector>
+
+#include "prop/sat_local_search.h"
+
+using namespace CVC4;
+using namespace CVC4::prop;
+using namespace std;
+
+class SatLocalSearchWhite : public CxxTest::TestSuite
+{
+  /** Literal of var with the given sign (true is negative). */
+  static unsigned lit(unsigned var, bool negated) { return 2 * var + negated; }
+
+ public:
+  void testSatisfiable()
+  {
+    // The implication chain x0 -> x1 -> ... -> x9 together with x0 has the
+    // all-true assignment as its only model
+    const unsigned n = 10;
+    SatLocalSearch sls(n);
+    sls.addClause({lit(0, false)});
+    for (unsigned i = 0; i + 1 < n; ++i)
+    {
+      sls.addClause({lit(i, true), lit(i + 1, false)});
+    }
+    for (unsigned i = 0; i < n; ++i)
+    {
+      sls.setValue(i, false);
+    }
+    TS_ASSERT(sls.run(10000));
+    TS_ASSERT_EQUALS(sls.bestUnsat(), 0u);
+    for (unsigned i = 0; i < n; ++i)
+    {
+      TS_ASSERT(sls.bestValue(i));
+    }
+  }
+
+  void testUnsatisfiable()
+  {
+    // x0 and not x0 -- one clause always stays falsified
+    SatLocalSearch sls(1);
+    sls.addClause({lit(0, false)});
+    sls.addClause({lit(0, true)});
+    TS_ASSERT(!sls.run(100));
+    TS_ASSERT_EQUALS(sls.bestUnsat(), 1u);
+    TS_ASSERT_EQUALS(sls.flips(), 100u);
+  }
+
+  void testInitialModel()
+  {
+    // Starting from a model no flips are needed
+    SatLocalSearch sls(2);
+    sls.addClause({lit(0, false), lit(1, false)});
+    sls.setValue(1, true);
+    TS_ASSERT(sls.run(100));
+    TS_ASSERT_EQUALS(sls.flips(), 0u);
+    TS_ASSERT(!sls.bestValue(0));
+    TS_ASSERT(sls.bestValue(1));
+  }
+};
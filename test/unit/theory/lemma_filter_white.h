@@ -0,0 +1,93 @@
+/*********************                                                        */
+/*! \file lemma_filter_white.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of CVC4::theory::LemmaFilter
+ **
+ ** White box testing of CVC4::theory::LemmaFilter.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include "context/context.h"
+#include "expr/expr_manager.h"
+#include "expr/node_manager.h"
+#include "theory/lemma_filter.h"
+
+using namespace CVC4;
+using namespace CVC4::context;
+using namespace CVC4::kind;
+using namespace CVC4::theory;
+
+class LemmaFilterWhite : public CxxTest::TestSuite
+{
+  ExprManager* d_em;
+  NodeManager* d_nm;
+  NodeManagerScope* d_scope;
+  UserContext* d_user;
+
+  Node d_a, d_b, d_c;
+
+ public:
+  void setUp() override
+  {
+    d_em = new ExprManager();
+    d_nm = NodeManager::fromExprManager(d_em);
+    d_scope = new NodeManagerScope(d_nm);
+    d_user = new UserContext();
+    d_a = d_nm->mkSkolem("a", d_nm->booleanType());
+    d_b = d_nm->mkSkolem("b", d_nm->booleanType());
+    d_c = d_nm->mkSkolem("c", d_nm->booleanType());
+  }
+
+  void tearDown() override
+  {
+    d_a = d_b = d_c = Node::null();
+    delete d_user;
+    delete d_scope;
+    delete d_em;
+  }
+
+  void testDuplicate()
+  {
+    LemmaFilter filter(d_user, 4);
+    Node ab = d_nm->mkNode(OR, d_a, d_b);
+    TS_ASSERT_EQUALS(filter.check(ab, true), LemmaFilter::NEW);
+    TS_ASSERT_EQUALS(filter.check(ab, true), LemmaFilter::DUPLICATE);
+    // removable lemmas are not remembered
+    TS_ASSERT_EQUALS(filter.check(d_c, false), LemmaFilter::NEW);
+    TS_ASSERT_EQUALS(filter.check(d_c, false), LemmaFilter::NEW);
+  }
+
+  void testSubsumed()
+  {
+    LemmaFilter filter(d_user, 4);
+    Node ab = d_nm->mkNode(OR, d_a, d_b);
+    Node abc = d_nm->mkNode(OR, d_a, d_b, d_c);
+    Node bc = d_nm->mkNode(OR, d_b, d_c);
+    TS_ASSERT_EQUALS(filter.check(ab, true), LemmaFilter::NEW);
+    TS_ASSERT_EQUALS(filter.check(abc, true), LemmaFilter::SUBSUMED);
+    TS_ASSERT_EQUALS(filter.check(bc, true), LemmaFilter::NEW);
+    TS_ASSERT_EQUALS(filter.check(d_c, true), LemmaFilter::NEW);
+    TS_ASSERT_EQUALS(filter.check(bc.notNode().orNode(d_c), true),
+                     LemmaFilter::SUBSUMED);
+  }
+
+  void testPop()
+  {
+    LemmaFilter filter(d_user, 4);
+    Node ab = d_nm->mkNode(OR, d_a, d_b);
+    Node abc = d_nm->mkNode(OR, d_a, d_b, d_c);
+    d_user->push();
+    TS_ASSERT_EQUALS(filter.check(ab, true), LemmaFilter::NEW);
+    TS_ASSERT_EQUALS(filter.check(ab, true), LemmaFilter::DUPLICATE);
+    d_user->pop();
+    TS_ASSERT_EQUALS(filter.check(abc, true), LemmaFilter::NEW);
+    TS_ASSERT_EQUALS(filter.check(ab, true), LemmaFilter::NEW);
+  }
+};
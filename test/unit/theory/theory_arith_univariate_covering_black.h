@@ -0,0 +1,129 @@
+/*********************                                                        */
+/*! \file theory_arith_univariate_covering_black.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of the univariate covering of the theory of
+ ** arithmetic.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <memory>
+
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "theory/arith/univariate_covering.h"
+#include "util/rational.h"
+
+using namespace CVC4;
+using namespace CVC4::theory::arith;
+
+class TheoryArithUnivariateCoveringBlack : public CxxTest::TestSuite
+{
+ public:
+  void setUp() override
+  {
+    d_nm.reset(new NodeManager(nullptr));
+    d_scope.reset(new NodeManagerScope(d_nm.get()));
+  }
+
+  void tearDown() override {}
+
+  UPoly mkPoly(std::vector<int> coeffs)
+  {
+    UPoly p;
+    for (int c : coeffs)
+    {
+      p.push_back(Rational(c));
+    }
+    return p;
+  }
+
+  void testCovered()
+  {
+    // x^2 > 2, x < 1, x > -1
+    UnivariateCovering uc;
+    uc.addConstraint(mkPoly({-2, 0, 1}), UnivariateCovering::SIGN_POS);
+    uc.addConstraint(mkPoly({-1, 1}), UnivariateCovering::SIGN_NEG);
+    uc.addConstraint(mkPoly({1, 1}), UnivariateCovering::SIGN_POS);
+    TS_ASSERT_EQUALS(uc.check(), UnivariateCovering::COVERED);
+    TS_ASSERT_EQUALS(uc.getCovering().size(), 3);
+
+    // x^2 < 0, x > 5: the first one covers the real line
+    UnivariateCovering uc2;
+    uc2.addConstraint(mkPoly({0, 0, 1}), UnivariateCovering::SIGN_NEG);
+    uc2.addConstraint(mkPoly({-5, 1}), UnivariateCovering::SIGN_POS);
+    TS_ASSERT_EQUALS(uc2.check(), UnivariateCovering::COVERED);
+    TS_ASSERT_EQUALS(uc2.getCovering(), std::vector<unsigned>(1, 0));
+  }
+
+  void testSample()
+  {
+    // x^3 - x > 0, x < 0
+    UnivariateCovering uc;
+    uc.addConstraint(mkPoly({0, -1, 0, 1}), UnivariateCovering::SIGN_POS);
+    uc.addConstraint(mkPoly({0, 1}), UnivariateCovering::SIGN_NEG);
+    TS_ASSERT_EQUALS(uc.check(), UnivariateCovering::SAMPLE);
+    TS_ASSERT(uc.getSample() > Rational(-1));
+    TS_ASSERT(uc.getSample() < Rational(0));
+
+    // x^2 = 4, x > 0: only satisfied at a root
+    UnivariateCovering uc2;
+    uc2.addConstraint(mkPoly({-4, 0, 1}), UnivariateCovering::SIGN_ZERO);
+    uc2.addConstraint(mkPoly({0, 1}), UnivariateCovering::SIGN_POS);
+    TS_ASSERT_EQUALS(uc2.check(), UnivariateCovering::SAMPLE);
+    TS_ASSERT_EQUALS(uc2.getSample(), Rational(2));
+  }
+
+  void testNoRationalSample()
+  {
+    // x^2 = 2
+    UnivariateCovering uc;
+    uc.addConstraint(mkPoly({-2, 0, 1}), UnivariateCovering::SIGN_ZERO);
+    TS_ASSERT_EQUALS(uc.check(), UnivariateCovering::NO_RATIONAL_SAMPLE);
+
+    // x^2 = 2, x > 0: holds at the positive root only
+    UnivariateCovering uc2;
+    uc2.addConstraint(mkPoly({-2, 0, 1}), UnivariateCovering::SIGN_ZERO);
+    uc2.addConstraint(mkPoly({0, 1}), UnivariateCovering::SIGN_POS);
+    TS_ASSERT_EQUALS(uc2.check(), UnivariateCovering::NO_RATIONAL_SAMPLE);
+
+    // x^2 = 2, x^3 < 2x: the roots are roots of both
+    UnivariateCovering uc3;
+    uc3.addConstraint(mkPoly({-2, 0, 1}), UnivariateCovering::SIGN_ZERO);
+    uc3.addConstraint(mkPoly({0, -2, 0, 1}), UnivariateCovering::SIGN_NEG);
+    TS_ASSERT_EQUALS(uc3.check(), UnivariateCovering::COVERED);
+  }
+
+  void testMkPolynomial()
+  {
+    Node x = d_nm->mkSkolem("x", d_nm->realType());
+    Node y = d_nm->mkSkolem("y", d_nm->realType());
+    Node two = d_nm->mkConst(Rational(2));
+    // 2*x*x - (x + 2)
+    Node t = d_nm->mkNode(
+        kind::MINUS,
+        d_nm->mkNode(kind::MULT,
+                     two,
+                     d_nm->mkNode(kind::NONLINEAR_MULT, x, x)),
+        d_nm->mkNode(kind::PLUS, x, two));
+    Node v;
+    UPoly p;
+    TS_ASSERT(UnivariateCovering::mkPolynomial(t, v, p));
+    TS_ASSERT_EQUALS(v, x);
+    TS_ASSERT_EQUALS(p, mkPoly({-2, -1, 2}));
+
+    Node v2;
+    TS_ASSERT(!UnivariateCovering::mkPolynomial(
+        d_nm->mkNode(kind::PLUS, x, y), v2, p));
+  }
+
+ private:
+  std::unique_ptr<NodeManager> d_nm;
+  std::unique_ptr<NodeManagerScope> d_scope;
+};
@@ -319,6 +319,37 @@ public:
     TS_ASSERT_EQUALS(act7, exp7);
     TS_ASSERT_EQUALS(act8, exp8);
   }
+  void testAddProduct(){
+    Rational x(3,2);
+    Rational y(7,8);
+    Rational z(-3,33);
+
+    Rational act0 = x;
+    act0.addProduct(y, z);
+    TS_ASSERT_EQUALS(act0, x + y * z);
+
+    Rational act1 = z;
+    act1.addProduct(z, z);
+    TS_ASSERT_EQUALS(act1, z + z * z);
+
+    // x + (-x / 1) * 1 cancels out
+    Rational act2 = x;
+    act2.addProduct(-x, Rational(1));
+    TS_ASSERT_EQUALS(act2, Rational(0));
+    TS_ASSERT_EQUALS(act2.getDenominator(), Integer(1));
+
+    // results that do not fit in a machine word
+    Integer big = Integer(1).multiplyByPow2(62);
+    Rational act3 = Rational(big);
+    act3.addProduct(Rational(big), Rational(4));
+    TS_ASSERT_EQUALS(act3, Rational(big * Integer(5)));
+
+    Rational act4 = Rational(1, 3);
+    act4.addProduct(Rational(Integer(1), big), Rational(1, 7));
+    TS_ASSERT_EQUALS(act4,
+                     Rational(1, 3) + Rational(Integer(1), big) * Rational(1, 7));
+  }
+
   void testOperatorDiv(){
     Rational x(3,2);
     Rational y(7,8);